@@ -0,0 +1,24 @@
+-- Verification of heap tuples with zstd-compressed TOAST values
+
+SELECT NOT(enumvals @> '{zstd}') AS skip_test FROM pg_settings WHERE
+  name = 'default_toast_compression' \gset
+\if :skip_test
+   \echo '*** skipping amcheck tests with zstd (not supported) ***'
+   \quit
+\endif
+
+CREATE TABLE zstdcheck (a integer, b text COMPRESSION zstd);
+REVOKE ALL ON zstdcheck FROM PUBLIC;
+
+-- Store both an inline compressed value and an externally stored
+-- compressed value.
+INSERT INTO zstdcheck VALUES (1, repeat('1234567890', 1000));
+INSERT INTO zstdcheck
+	SELECT 2, string_agg(g::text, '0123456789') FROM generate_series(1, 10000) g;
+SELECT a, pg_column_compression(b) FROM zstdcheck ORDER BY a;
+
+-- Check that verify_heapam accepts the compression method and can follow
+-- the TOAST pointers.
+SELECT * FROM verify_heapam(relation := 'zstdcheck');
+
+DROP TABLE zstdcheck;
@@ -59,6 +59,7 @@ typedef struct BlockInfoRecord
 	RelFileNumber filenumber;
 	ForkNumber	forknum;
 	BlockNumber blocknum;
+	uint32		usagecount;		/* buffer usage count at dump time */
 } BlockInfoRecord;
 
 /* Shared state information for autoprewarm bgworker. */
@@ -111,6 +112,7 @@ static void apw_start_database_worker(void);
 static bool apw_init_shmem(void);
 static void apw_detach_shmem(int code, Datum arg);
 static int	apw_compare_blockinfo(const void *p, const void *q);
+static int	apw_compare_usagecount(const void *p, const void *q);
 
 /* Pointer to shared-memory state. */
 static AutoPrewarmSharedState *apw_state = NULL;
@@ -349,10 +351,24 @@ apw_load_buffers(void)
 	for (i = 0; i < num_elements; i++)
 	{
 		unsigned	forknum;
+		int			nfields;
+		char		line[128];
 
-		if (fscanf(file, "%u,%u,%u,%u,%u\n", &blkinfo[i].database,
-				   &blkinfo[i].tablespace, &blkinfo[i].filenumber,
-				   &forknum, &blkinfo[i].blocknum) != 5)
+		if (fgets(line, sizeof(line), file) == NULL)
+			ereport(ERROR,
+					(errmsg("autoprewarm block dump file is corrupted at line %d",
+							i + 1)));
+
+		/*
+		 * The usage count is a recent addition to the format; dump files
+		 * written without it are still accepted.
+		 */
+		blkinfo[i].usagecount = 1;
+		nfields = sscanf(line, "%u,%u,%u,%u,%u,%u", &blkinfo[i].database,
+						 &blkinfo[i].tablespace, &blkinfo[i].filenumber,
+						 &forknum, &blkinfo[i].blocknum,
+						 &blkinfo[i].usagecount);
+		if (nfields != 5 && nfields != 6)
 			ereport(ERROR,
 					(errmsg("autoprewarm block dump file is corrupted at line %d",
 							i + 1)));
@@ -361,6 +377,19 @@ apw_load_buffers(void)
 
 	FreeFile(file);
 
+	/*
+	 * If there are more blocks in the dump than fit in shared buffers, keep
+	 * the ones that were hottest at dump time.  Loading stops once the free
+	 * buffers run out, so without this the surviving subset would just be
+	 * whatever sorts first.
+	 */
+	if (num_elements > NBuffers)
+	{
+		qsort(blkinfo, num_elements, sizeof(BlockInfoRecord),
+			  apw_compare_usagecount);
+		num_elements = NBuffers;
+	}
+
 	/* Sort the blocks to be loaded. */
 	qsort(blkinfo, num_elements, sizeof(BlockInfoRecord),
 		  apw_compare_blockinfo);
@@ -729,6 +758,8 @@ apw_dump_now(bool is_bgworker, bool dump_unlogged)
 			block_info_array[num_blocks].forknum =
 				BufTagGetForkNum(&bufHdr->tag);
 			block_info_array[num_blocks].blocknum = bufHdr->tag.blockNum;
+			block_info_array[num_blocks].usagecount =
+				BUF_STATE_GET_USAGECOUNT(buf_state);
 			++num_blocks;
 		}
 
@@ -761,12 +792,13 @@ apw_dump_now(bool is_bgworker, bool dump_unlogged)
 	{
 		CHECK_FOR_INTERRUPTS();
 
-		ret = fprintf(file, "%u,%u,%u,%u,%u\n",
+		ret = fprintf(file, "%u,%u,%u,%u,%u,%u\n",
 					  block_info_array[i].database,
 					  block_info_array[i].tablespace,
 					  block_info_array[i].filenumber,
 					  (uint32) block_info_array[i].forknum,
-					  block_info_array[i].blocknum);
+					  block_info_array[i].blocknum,
+					  block_info_array[i].usagecount);
 		if (ret < 0)
 		{
 			int			save_errno = errno;
@@ -1009,3 +1041,21 @@ apw_compare_blockinfo(const void *p, const void *q)
 
 	return 0;
 }
+
+/*
+ * apw_compare_usagecount
+ *
+ * Sort hottest blocks first.  Ties are broken by block location so that the
+ * result is deterministic.
+ */
+static int
+apw_compare_usagecount(const void *p, const void *q)
+{
+	const BlockInfoRecord *a = (const BlockInfoRecord *) p;
+	const BlockInfoRecord *b = (const BlockInfoRecord *) q;
+
+	if (a->usagecount != b->usagecount)
+		return a->usagecount > b->usagecount ? -1 : 1;
+
+	return apw_compare_blockinfo(p, q);
+}
@@ -581,6 +581,9 @@ bringetbitmap(IndexScanDesc scan, TIDBitmap *tbm)
 	BrinMemTuple *dtup;
 	BrinTuple  *btup = NULL;
 	Size		btupsz = 0;
+	ItemPointerData *revmap_tids;
+	int			nrevmap_tids = 0;
+	int			revmap_idx = 0;
 	ScanKey   **keys,
 			  **nullkeys;
 	int		   *nkeys,
@@ -723,6 +726,14 @@ bringetbitmap(IndexScanDesc scan, TIDBitmap *tbm)
 	/* allocate an initial in-memory tuple, out of the per-range memcxt */
 	dtup = brin_new_memtuple(bdesc);
 
+	/*
+	 * Space for a batch of revmap TIDs, read one whole revmap page at a time
+	 * so we don't have to lock and unlock the same revmap page once per
+	 * range.  Allocated here so that it survives the per-range context
+	 * resets below.
+	 */
+	revmap_tids = palloc_array(ItemPointerData, REVMAP_PAGE_MAXITEMS);
+
 	/*
 	 * Setup and use a per-range memory context, which is reset every time we
 	 * loop below.  This avoids having to free the tuples within the loop.
@@ -749,8 +760,24 @@ bringetbitmap(IndexScanDesc scan, TIDBitmap *tbm)
 
 		MemoryContextReset(perRangeCxt);
 
-		tup = brinGetTupleForHeapBlock(opaque->bo_rmAccess, heapBlk, &buf,
-									   &off, &size, BUFFER_LOCK_SHARE);
+		/*
+		 * Refill the revmap TID batch whenever we run out.  Each iteration
+		 * advances by exactly one range, so consuming one entry per loop
+		 * keeps us in step with the batch.  The TIDs are mere hints: if one
+		 * turns out to be stale, brinGetTupleForHeapBlockAtTid falls back to
+		 * the authoritative revmap lookup.
+		 */
+		if (revmap_idx >= nrevmap_tids)
+		{
+			nrevmap_tids = brinRevmapGetTids(opaque->bo_rmAccess, heapBlk,
+											 revmap_tids,
+											 REVMAP_PAGE_MAXITEMS);
+			revmap_idx = 0;
+		}
+
+		tup = brinGetTupleForHeapBlockAtTid(opaque->bo_rmAccess, heapBlk,
+											revmap_tids[revmap_idx++], &buf,
+											&off, &size, BUFFER_LOCK_SHARE);
 		if (tup)
 		{
 			gottuple = true;
@@ -312,6 +312,126 @@ brinGetTupleForHeapBlock(BrinRevmap *revmap, BlockNumber heapBlk,
 	return NULL;
 }
 
+/*
+ * Fetch revmap TIDs for a run of consecutive page ranges in bulk.
+ *
+ * Fills tids[] with the revmap entries for up to ntids page ranges, starting
+ * with the range containing heapBlk.  The batch stops at the end of the
+ * revmap page holding the first entry, so that one lock/unlock cycle covers
+ * the whole batch; the next call simply continues on the next revmap page.
+ * Returns the number of entries filled, always at least 1.  Entries for
+ * unsummarized ranges are invalid item pointers.
+ *
+ * The returned TIDs are a snapshot: a concurrent summarization or update
+ * can invalidate them at any time.  Callers must treat them as hints and
+ * cope with stale values, e.g. by using brinGetTupleForHeapBlockAtTid.
+ */
+int
+brinRevmapGetTids(BrinRevmap *revmap, BlockNumber heapBlk,
+				  ItemPointerData *tids, int ntids)
+{
+	BlockNumber mapBlk;
+	RevmapContents *contents;
+	int			idx;
+	int			n;
+
+	/* normalize the heap block number to be the first page in the range */
+	heapBlk = (heapBlk / revmap->rm_pagesPerRange) * revmap->rm_pagesPerRange;
+
+	idx = HEAPBLK_TO_REVMAP_INDEX(revmap->rm_pagesPerRange, heapBlk);
+	n = Min(ntids, REVMAP_PAGE_MAXITEMS - idx);
+	Assert(n > 0);
+
+	/*
+	 * If the revmap page hasn't been created yet, all the ranges it would
+	 * cover are unsummarized.
+	 */
+	mapBlk = revmap_get_blkno(revmap, heapBlk);
+	if (mapBlk == InvalidBlockNumber)
+	{
+		for (int i = 0; i < n; i++)
+			ItemPointerSetInvalid(&tids[i]);
+		return n;
+	}
+
+	if (revmap->rm_currBuf == InvalidBuffer ||
+		BufferGetBlockNumber(revmap->rm_currBuf) != mapBlk)
+	{
+		if (revmap->rm_currBuf != InvalidBuffer)
+			ReleaseBuffer(revmap->rm_currBuf);
+
+		revmap->rm_currBuf = ReadBuffer(revmap->rm_irel, mapBlk);
+	}
+
+	LockBuffer(revmap->rm_currBuf, BUFFER_LOCK_SHARE);
+	contents = (RevmapContents *)
+		PageGetContents(BufferGetPage(revmap->rm_currBuf));
+	memcpy(tids, contents->rm_tids + idx, n * sizeof(ItemPointerData));
+	LockBuffer(revmap->rm_currBuf, BUFFER_LOCK_UNLOCK);
+
+	return n;
+}
+
+/*
+ * Like brinGetTupleForHeapBlock, but first try a revmap TID previously
+ * obtained from brinRevmapGetTids, saving the revmap page access when the
+ * TID is still current.  If anything about the TID turns out to be stale --
+ * the range was desummarized, or its summary tuple was moved -- fall back to
+ * the authoritative lookup, which re-reads the revmap.
+ */
+BrinTuple *
+brinGetTupleForHeapBlockAtTid(BrinRevmap *revmap, BlockNumber heapBlk,
+							  ItemPointerData tid, Buffer *buf,
+							  OffsetNumber *off, Size *size, int mode)
+{
+	BlockNumber blk;
+	Page		page;
+	ItemId		lp;
+	BrinTuple  *tup;
+
+	if (!ItemPointerIsValid(&tid))
+	{
+		*off = InvalidOffsetNumber;
+		return NULL;
+	}
+
+	/* normalize the heap block number to be the first page in the range */
+	heapBlk = (heapBlk / revmap->rm_pagesPerRange) * revmap->rm_pagesPerRange;
+
+	blk = ItemPointerGetBlockNumber(&tid);
+	*off = ItemPointerGetOffsetNumber(&tid);
+
+	if (!BufferIsValid(*buf) || BufferGetBlockNumber(*buf) != blk)
+	{
+		if (BufferIsValid(*buf))
+			ReleaseBuffer(*buf);
+		*buf = ReadBuffer(revmap->rm_irel, blk);
+	}
+	LockBuffer(*buf, mode);
+	page = BufferGetPage(*buf);
+
+	if (BRIN_IS_REGULAR_PAGE(page) && *off <= PageGetMaxOffsetNumber(page))
+	{
+		lp = PageGetItemId(page, *off);
+		if (ItemIdIsUsed(lp))
+		{
+			tup = (BrinTuple *) PageGetItem(page, lp);
+
+			if (tup->bt_blkno == heapBlk)
+			{
+				if (size)
+					*size = ItemIdGetLength(lp);
+				/* found it! */
+				return tup;
+			}
+		}
+	}
+
+	/* TID is stale; do it the hard way */
+	LockBuffer(*buf, BUFFER_LOCK_UNLOCK);
+	return brinGetTupleForHeapBlock(revmap, heapBlk, buf, off, size, mode);
+}
+
 /*
  * Delete an index tuple, marking a page range as unsummarized.
  *
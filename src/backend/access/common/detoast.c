@@ -19,9 +19,47 @@
 #include "access/toast_internals.h"
 #include "common/int.h"
 #include "common/pg_lzcompress.h"
+#include "storage/proc.h"
 #include "utils/expandeddatum.h"
+#include "utils/memutils.h"
 #include "utils/rel.h"
 
+/*
+ * Cache of recently detoasted external values.
+ *
+ * A toasted value referenced several times in one query is fetched and
+ * decompressed once per reference, which is painful for large documents.
+ * Since externally stored values are immutable (an update creates a new
+ * value ID), we can remember the last few results and hand out copies.
+ * The cache lives for the current top-level transaction: the values are
+ * kept in a child context of TopTransactionContext, and we detect the
+ * context's demise by watching our local transaction ID.
+ *
+ * Sizing is deliberately modest: this targets the repeated-large-document
+ * pattern, not general toast traffic, and small values are cheap enough to
+ * refetch.
+ */
+typedef struct ToastCacheEntry
+{
+	struct varatt_external ptr; /* the external pointer this came from */
+	struct varlena *value;		/* detoasted copy, in ToastCacheContext */
+	Size		size;			/* VARSIZE(value) */
+	uint64		last_used;		/* for LRU replacement */
+} ToastCacheEntry;
+
+#define TOAST_CACHE_ENTRIES		8
+#define TOAST_CACHE_MAX_VALUE	(4 * 1024 * 1024)
+#define TOAST_CACHE_MAX_TOTAL	(8 * 1024 * 1024)
+
+static ToastCacheEntry toast_cache[TOAST_CACHE_ENTRIES];
+static Size toast_cache_total = 0;
+static uint64 toast_cache_clock = 0;
+static MemoryContext ToastCacheContext = NULL;
+static LocalTransactionId toast_cache_lxid = InvalidLocalTransactionId;
+
+static struct varlena *toast_cache_lookup(struct varlena *attr);
+static void toast_cache_insert(struct varlena *attr, struct varlena *value);
+
 static struct varlena *toast_fetch_datum(struct varlena *attr);
 static struct varlena *toast_fetch_datum_slice(struct varlena *attr,
 											   int32 sliceoffset,
@@ -117,6 +155,14 @@ detoast_attr(struct varlena *attr)
 {
 	if (VARATT_IS_EXTERNAL_ONDISK(attr))
 	{
+		struct varlena *toast_ptr = attr;
+		struct varlena *cached;
+
+		/* Did we already detoast this same value recently? */
+		cached = toast_cache_lookup(toast_ptr);
+		if (cached != NULL)
+			return cached;
+
 		/*
 		 * This is an externally stored datum --- fetch it back from there
 		 */
@@ -129,6 +175,9 @@ detoast_attr(struct varlena *attr)
 			attr = toast_decompress_datum(tmp);
 			pfree(tmp);
 		}
+
+		/* Remember the result in case the same value is referenced again */
+		toast_cache_insert(toast_ptr, attr);
 	}
 	else if (VARATT_IS_EXTERNAL_INDIRECT(attr))
 	{
@@ -332,6 +381,130 @@ detoast_attr_slice(struct varlena *attr,
 	return result;
 }
 
+/* ----------
+ * toast_cache_lookup -
+ *
+ *	Check whether we hold a cached copy of the value referenced by the
+ *	given external toast pointer.  On a hit, return a fresh copy palloc'd
+ *	in the current memory context (detoast_attr's callers own the result
+ *	and may pfree it); on a miss, return NULL.
+ * ----------
+ */
+static struct varlena *
+toast_cache_lookup(struct varlena *attr)
+{
+	struct varatt_external toast_pointer;
+	int			i;
+
+	/* Any cached values died with the transaction that installed them */
+	if (MyProc == NULL || toast_cache_lxid != MyProc->vxid.lxid)
+	{
+		memset(toast_cache, 0, sizeof(toast_cache));
+		toast_cache_total = 0;
+		ToastCacheContext = NULL;
+		toast_cache_lxid = (MyProc != NULL) ? MyProc->vxid.lxid :
+			InvalidLocalTransactionId;
+		return NULL;
+	}
+
+	VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
+
+	for (i = 0; i < TOAST_CACHE_ENTRIES; i++)
+	{
+		ToastCacheEntry *entry = &toast_cache[i];
+		struct varlena *result;
+
+		if (entry->value == NULL ||
+			memcmp(&entry->ptr, &toast_pointer, sizeof(toast_pointer)) != 0)
+			continue;
+
+		entry->last_used = ++toast_cache_clock;
+		result = (struct varlena *) palloc(entry->size);
+		memcpy(result, entry->value, entry->size);
+		return result;
+	}
+
+	return NULL;
+}
+
+/* ----------
+ * toast_cache_insert -
+ *
+ *	Remember a freshly detoasted value for possible reuse, evicting
+ *	less recently used entries as needed to stay within the cache's
+ *	size limits.
+ * ----------
+ */
+static void
+toast_cache_insert(struct varlena *attr, struct varlena *value)
+{
+	struct varatt_external toast_pointer;
+	Size		size = VARSIZE(value);
+	ToastCacheEntry *victim;
+	int			i;
+
+	/* Cache only within a transaction, and only reasonably sized values */
+	if (TopTransactionContext == NULL ||
+		MyProc == NULL ||
+		toast_cache_lxid != MyProc->vxid.lxid ||
+		size > TOAST_CACHE_MAX_VALUE)
+		return;
+
+	VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
+
+	/* Evict least recently used entries until the new value fits */
+	while (toast_cache_total + size > TOAST_CACHE_MAX_TOTAL)
+	{
+		victim = NULL;
+		for (i = 0; i < TOAST_CACHE_ENTRIES; i++)
+		{
+			ToastCacheEntry *entry = &toast_cache[i];
+
+			if (entry->value != NULL &&
+				(victim == NULL || entry->last_used < victim->last_used))
+				victim = entry;
+		}
+		Assert(victim != NULL);
+		pfree(victim->value);
+		toast_cache_total -= victim->size;
+		victim->value = NULL;
+	}
+
+	/* Claim a slot: prefer an empty one, else the least recently used */
+	victim = NULL;
+	for (i = 0; i < TOAST_CACHE_ENTRIES; i++)
+	{
+		ToastCacheEntry *entry = &toast_cache[i];
+
+		if (entry->value == NULL)
+		{
+			victim = entry;
+			break;
+		}
+		if (victim == NULL || entry->last_used < victim->last_used)
+			victim = entry;
+	}
+	if (victim->value != NULL)
+	{
+		pfree(victim->value);
+		toast_cache_total -= victim->size;
+		victim->value = NULL;
+	}
+
+	if (ToastCacheContext == NULL)
+		ToastCacheContext = AllocSetContextCreate(TopTransactionContext,
+												  "detoast cache",
+												  ALLOCSET_DEFAULT_SIZES);
+
+	victim->ptr = toast_pointer;
+	victim->value = (struct varlena *)
+		MemoryContextAlloc(ToastCacheContext, size);
+	memcpy(victim->value, value, size);
+	victim->size = size;
+	victim->last_used = ++toast_cache_clock;
+	toast_cache_total += size;
+}
+
 /* ----------
  * toast_fetch_datum -
  *
@@ -485,6 +658,8 @@ toast_decompress_datum(struct varlena *attr)
 			return pglz_decompress_datum(attr);
 		case TOAST_LZ4_COMPRESSION_ID:
 			return lz4_decompress_datum(attr);
+		case TOAST_ZSTD_COMPRESSION_ID:
+			return zstd_decompress_datum(attr);
 		default:
 			elog(ERROR, "invalid compression method id %d", cmid);
 			return NULL;		/* keep compiler quiet */
@@ -528,6 +703,8 @@ toast_decompress_datum_slice(struct varlena *attr, int32 slicelength)
 			return pglz_decompress_datum_slice(attr, slicelength);
 		case TOAST_LZ4_COMPRESSION_ID:
 			return lz4_decompress_datum_slice(attr, slicelength);
+		case TOAST_ZSTD_COMPRESSION_ID:
+			return zstd_decompress_datum_slice(attr, slicelength);
 		default:
 			elog(ERROR, "invalid compression method id %d", cmid);
 			return NULL;		/* keep compiler quiet */
@@ -466,9 +466,25 @@ ginHeapTupleFastInsert(GinState *ginstate, GinTupleCollector *collector)
 	/*
 	 * Since it could contend with concurrent cleanup process we cleanup
 	 * pending list not forcibly.
+	 *
+	 * Prefer to hand the cleanup to an autovacuum worker, so that no
+	 * foreground query has to absorb its cost.  Only if the request cannot
+	 * be recorded -- or autovacuum is disabled, leaving nobody to pick the
+	 * item up -- do the work ourselves, as formerly.  Temporary indexes
+	 * cannot be accessed from an autovacuum worker at all, so for those we
+	 * always clean up here.
 	 */
 	if (needCleanup)
-		ginInsertCleanup(ginstate, false, true, false, NULL);
+	{
+		bool		recorded = false;
+
+		if (AutoVacuumingActive() && !RelationUsesLocalBuffers(index))
+			recorded = AutoVacuumRequestWork(AVW_GINCleanPendingList,
+											 RelationGetRelid(index),
+											 InvalidBlockNumber);
+		if (!recorded)
+			ginInsertCleanup(ginstate, false, true, false, NULL);
+	}
 }
 
 /*
@@ -795,6 +795,56 @@ entryLoadMoreItems(GinState *ginstate, GinScanEntry entry,
 #define gin_rand() pg_prng_double(&pg_global_prng_state)
 #define dropItem(e) ( gin_rand() > ((double)GinFuzzySearchLimit)/((double)((e)->predictNumberResult)) )
 
+/*
+ * Find the offset of the first item in entry->list, at or beyond
+ * entry->offset, that is > advancePast.  Returns entry->nlist if there is
+ * none.
+ *
+ * When several entry streams are intersected, advancePast is driven by the
+ * rarest term, so frequent terms may have to skip over long runs of items
+ * here.  Gallop forward in exponentially growing steps and then binary
+ * search, rather than comparing item-by-item; the fast path still answers
+ * the common case of advancing by a single item with one comparison.
+ */
+static int
+entryFindItem(GinScanEntry entry, ItemPointerData advancePast)
+{
+	int			low = entry->offset;
+	int			high;
+	int			step;
+
+	/* Fast path: very often the next unread item already qualifies. */
+	if (low >= entry->nlist ||
+		ginCompareItemPointers(&entry->list[low], &advancePast) > 0)
+		return low;
+
+	/* Gallop to establish a window (low, high] holding the first match */
+	step = 1;
+	high = low + step;
+	while (high < entry->nlist &&
+		   ginCompareItemPointers(&entry->list[high], &advancePast) <= 0)
+	{
+		low = high;
+		step *= 2;
+		high = low + step;
+	}
+	if (high > entry->nlist)
+		high = entry->nlist;
+
+	/* Binary search; invariant: list[low] <= advancePast < list[high] */
+	while (high - low > 1)
+	{
+		int			mid = low + (high - low) / 2;
+
+		if (ginCompareItemPointers(&entry->list[mid], &advancePast) <= 0)
+			low = mid;
+		else
+			high = mid;
+	}
+
+	return high;
+}
+
 /*
  * Sets entry->curItem to next heap item pointer > advancePast, for one entry
  * of one scan key, or sets entry->isFinished to true if there are no more.
@@ -926,6 +976,8 @@ entryGetItem(GinState *ginstate, GinScanEntry entry,
 		 */
 		for (;;)
 		{
+			/* Skip to the first item > advancePast */
+			entry->offset = entryFindItem(entry, advancePast);
 			if (entry->offset >= entry->nlist)
 			{
 				ItemPointerSetInvalid(&entry->curItem);
@@ -935,10 +987,6 @@ entryGetItem(GinState *ginstate, GinScanEntry entry,
 
 			entry->curItem = entry->list[entry->offset++];
 
-			/* If we're not past advancePast, keep scanning */
-			if (ginCompareItemPointers(&entry->curItem, &advancePast) <= 0)
-				continue;
-
 			/* Done unless we need to reduce the result */
 			if (!entry->reduceResult || !dropItem(entry))
 				break;
@@ -949,8 +997,11 @@ entryGetItem(GinState *ginstate, GinScanEntry entry,
 		/* A posting tree */
 		for (;;)
 		{
-			/* If we've processed the current batch, load more items */
-			while (entry->offset >= entry->nlist)
+			/*
+			 * Skip to the first item > advancePast in the current batch; if
+			 * that exhausts the batch, load more items.
+			 */
+			while ((entry->offset = entryFindItem(entry, advancePast)) >= entry->nlist)
 			{
 				entryLoadMoreItems(ginstate, entry, advancePast);
 
@@ -963,10 +1014,6 @@ entryGetItem(GinState *ginstate, GinScanEntry entry,
 
 			entry->curItem = entry->list[entry->offset++];
 
-			/* If we're not past advancePast, keep scanning */
-			if (ginCompareItemPointers(&entry->curItem, &advancePast) <= 0)
-				continue;
-
 			/* Done unless we need to reduce the result */
 			if (!entry->reduceResult || !dropItem(entry))
 				break;
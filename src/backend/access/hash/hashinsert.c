@@ -19,6 +19,7 @@
 #include "access/hash_xlog.h"
 #include "access/xloginsert.h"
 #include "miscadmin.h"
+#include "postmaster/autovacuum.h"
 #include "storage/predicate.h"
 #include "utils/rel.h"
 
@@ -249,7 +250,25 @@ restart_insert:
 
 	/* Attempt to split if a split is needed */
 	if (do_expand)
-		_hash_expandtable(rel, metabuf);
+	{
+		bool		recorded = false;
+
+		/*
+		 * Prefer to hand the expansion off to an autovacuum worker, so that
+		 * this backend doesn't have to pay for relocating tuples and
+		 * possibly extending the relation by a splitpoint's worth of pages.
+		 * Temp indexes are invisible to autovacuum, and with autovacuum
+		 * disabled nobody would ever process the request; in those cases,
+		 * and when the work item couldn't be recorded, split here as before.
+		 */
+		if (AutoVacuumingActive() && !RelationUsesLocalBuffers(rel))
+			recorded = AutoVacuumRequestWork(AVW_HashExpandTable,
+											 RelationGetRelid(rel),
+											 InvalidBlockNumber);
+
+		if (!recorded)
+			_hash_expandtable(rel, metabuf);
+	}
 
 	/* Finally drop our pin on the metapage */
 	_hash_dropbuf(rel, metabuf);
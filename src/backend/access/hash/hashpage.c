@@ -28,9 +28,11 @@
  */
 #include "postgres.h"
 
+#include "access/genam.h"
 #include "access/hash.h"
 #include "access/hash_xlog.h"
 #include "access/xloginsert.h"
+#include "catalog/pg_am.h"
 #include "miscadmin.h"
 #include "port/pg_bitutils.h"
 #include "storage/predicate.h"
@@ -964,6 +966,76 @@ fail:
 }
 
 
+/*
+ * Expand a hash index on behalf of an autovacuum work item.
+ *
+ * When an inserting backend notices that the fill factor has been exceeded,
+ * it requests this work rather than splitting buckets itself, so that insert
+ * latency doesn't suffer from moving tuples around or extending the relation
+ * by a whole splitpoint's worth of pages.  By the time we get here more
+ * tuples may have accumulated, so keep splitting until the fill factor is
+ * satisfied again.
+ *
+ * The index is identified by OID because work items outlive any relcache
+ * reference; it may have been dropped and the OID even reused, so check that
+ * we are still looking at a hash index before touching it.
+ */
+void
+_hash_expand_workitem(Oid indexoid)
+{
+	Relation	rel;
+	Buffer		metabuf;
+	HashMetaPage metap;
+
+	rel = index_open(indexoid, RowExclusiveLock);
+
+	if (rel->rd_rel->relam != HASH_AM_OID)
+	{
+		index_close(rel, RowExclusiveLock);
+		return;
+	}
+
+	metabuf = _hash_getbuf(rel, HASH_METAPAGE, HASH_NOLOCK, LH_META_PAGE);
+	metap = HashPageGetMeta(BufferGetPage(metabuf));
+
+	for (;;)
+	{
+		uint32		old_maxbucket;
+		bool		expand;
+
+		CHECK_FOR_INTERRUPTS();
+
+		/* Make sure this stays in sync with _hash_doinsert() */
+		LockBuffer(metabuf, BUFFER_LOCK_SHARE);
+		old_maxbucket = metap->hashm_maxbucket;
+		expand = metap->hashm_ntuples >
+			(double) metap->hashm_ffactor * (metap->hashm_maxbucket + 1);
+		LockBuffer(metabuf, BUFFER_LOCK_UNLOCK);
+
+		if (!expand)
+			break;
+
+		_hash_expandtable(rel, metabuf);
+
+		/*
+		 * _hash_expandtable silently does nothing if it cannot get the
+		 * cleanup locks it needs; if no bucket was added, give up rather
+		 * than spin.  The next insert over the fill factor will queue a
+		 * fresh work item.
+		 */
+		LockBuffer(metabuf, BUFFER_LOCK_SHARE);
+		expand = (metap->hashm_maxbucket != old_maxbucket);
+		LockBuffer(metabuf, BUFFER_LOCK_UNLOCK);
+
+		if (!expand)
+			break;
+	}
+
+	_hash_dropbuf(rel, metabuf);
+	index_close(rel, RowExclusiveLock);
+}
+
+
 /*
  * _hash_alloc_buckets -- allocate a new splitpoint's worth of bucket pages
  *
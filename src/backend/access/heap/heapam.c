@@ -320,7 +320,7 @@ bitmapheap_stream_read_next(ReadStream *pgsr, void *private_data,
 		CHECK_FOR_INTERRUPTS();
 
 		/* no more entries in the bitmap */
-		if (!tbm_iterate(&sscan->st.rs_tbmiterator, tbmres))
+		if (!tbm_iterate(&sscan->st.bitmap.rs_tbmiterator, tbmres))
 			return InvalidBlockNumber;
 
 		/*
@@ -1707,13 +1707,17 @@ heap_fetch(Relation relation,
  * globally dead; *all_dead is set true if all members of the HOT chain
  * are vacuumable, false if not.
  *
+ * If chain_length is not NULL, *chain_length is set to the number of chain
+ * members this call had to examine.  Callers can use this to notice
+ * unusually long HOT chains and react, e.g. by attempting to prune the page.
+ *
  * Unlike heap_fetch, the caller must already have pin and (at least) share
  * lock on the buffer; it is still pinned/locked at exit.
  */
 bool
 heap_hot_search_buffer(ItemPointer tid, Relation relation, Buffer buffer,
 					   Snapshot snapshot, HeapTuple heapTuple,
-					   bool *all_dead, bool first_call)
+					   bool *all_dead, int *chain_length, bool first_call)
 {
 	Page		page = BufferGetPage(buffer);
 	TransactionId prev_xmax = InvalidTransactionId;
@@ -1727,6 +1731,8 @@ heap_hot_search_buffer(ItemPointer tid, Relation relation, Buffer buffer,
 	/* If this is not the first call, previous call returned a (live!) tuple */
 	if (all_dead)
 		*all_dead = first_call;
+	if (chain_length)
+		*chain_length = 0;
 
 	blkno = ItemPointerGetBlockNumber(tid);
 	offnum = ItemPointerGetOffsetNumber(tid);
@@ -1763,6 +1769,9 @@ heap_hot_search_buffer(ItemPointer tid, Relation relation, Buffer buffer,
 			break;
 		}
 
+		if (chain_length)
+			(*chain_length)++;
+
 		/*
 		 * Update heapTuple to point to the element of the HOT chain we're
 		 * currently investigating. Having t_self set correctly is important
@@ -2457,6 +2466,19 @@ heap_multi_insert(Relation relation, TupleTableSlot **slots, int ntuples,
 		if (starting_with_empty_page && (options & HEAP_INSERT_FROZEN))
 			all_frozen_set = true;
 
+		/*
+		 * If we're going to set the page all-frozen and need WAL, the
+		 * visibility map update is piggybacked on the multi-insert record,
+		 * so the map page must be locked before entering the critical
+		 * section below.  (In the !needwal case, visibilitymap_set does its
+		 * own locking after the critical section.)
+		 */
+		if (all_frozen_set && needwal)
+		{
+			Assert(visibilitymap_pin_ok(BufferGetBlockNumber(buffer), vmbuffer));
+			LockBuffer(vmbuffer, BUFFER_LOCK_EXCLUSIVE);
+		}
+
 		/* NO EREPORT(ERROR) from here till changes are logged */
 		START_CRIT_SECTION();
 
@@ -2620,21 +2642,48 @@ heap_multi_insert(Relation relation, TupleTableSlot **slots, int ntuples,
 
 			XLogRegisterBufData(0, tupledata, totaldatalen);
 
+			/*
+			 * Register the visibility map page too when we're setting the
+			 * all-frozen bit, so that the map update is covered by this
+			 * record and we need not emit a separate XLOG_HEAP2_VISIBLE
+			 * record for it.  The bits must be set on the page before the
+			 * record is inserted, so that any full-page image taken of the
+			 * map page includes them.
+			 */
+			if (all_frozen_set)
+			{
+				XLogRegisterBuffer(1, vmbuffer, 0);
+
+				visibilitymap_set_vmbits(relation,
+										 BufferGetBlockNumber(buffer),
+										 vmbuffer,
+										 VISIBILITYMAP_ALL_VISIBLE |
+										 VISIBILITYMAP_ALL_FROZEN);
+			}
+
 			/* filtering by origin on a row level is much more efficient */
 			XLogSetRecordFlags(XLOG_INCLUDE_ORIGIN);
 
 			recptr = XLogInsert(RM_HEAP2_ID, info);
 
 			PageSetLSN(page, recptr);
+
+			if (all_frozen_set)
+				PageSetLSN(BufferGetPage(vmbuffer), recptr);
 		}
 
 		END_CRIT_SECTION();
 
+		if (all_frozen_set && needwal)
+			LockBuffer(vmbuffer, BUFFER_LOCK_UNLOCK);
+
 		/*
-		 * If we've frozen everything on the page, update the visibilitymap.
-		 * We're already holding pin on the vmbuffer.
+		 * If we've frozen everything on the page but didn't write WAL (and
+		 * hence couldn't piggyback the map update on the multi-insert
+		 * record above), update the visibilitymap here.  We're already
+		 * holding pin on the vmbuffer.
 		 */
-		if (all_frozen_set)
+		if (all_frozen_set && !needwal)
 		{
 			Assert(PageIsAllVisible(page));
 			Assert(visibilitymap_pin_ok(BufferGetBlockNumber(buffer), vmbuffer));
@@ -3267,6 +3316,7 @@ heap_update(Relation relation, ItemPointer otid, HeapTuple newtup,
 	bool		have_tuple_lock = false;
 	bool		iscombo;
 	bool		use_hot_update = false;
+	bool		tried_eager_prune = false;
 	bool		summarized_update = false;
 	bool		key_intact;
 	bool		all_visible_cleared = false;
@@ -3938,6 +3988,22 @@ l2:
 		 */
 		for (;;)
 		{
+			/*
+			 * If the new tuple doesn't fit but a HOT update would otherwise
+			 * be possible, try pruning the page to make room before we give
+			 * up on same-page placement.  The page is certainly dirty (we
+			 * just marked the old tuple locked), so the eager prune cannot
+			 * cause extra writes.  The free-space figure we read afterwards
+			 * without the lock is just a hint; it gets rechecked below.
+			 */
+			if (newtupsize > pagefree && !tried_eager_prune &&
+				!bms_overlap(modified_attrs, hot_attrs))
+			{
+				tried_eager_prune = true;
+				heap_page_prune_opt_eager(relation, buffer);
+				pagefree = PageGetHeapFreeSpace(page);
+			}
+
 			if (newtupsize > pagefree)
 			{
 				/* It doesn't fit, must use RelationGetBufferForTuple. */
@@ -3972,6 +4038,21 @@ l2:
 				break;
 			}
 		}
+
+		/*
+		 * If we pruned the old page above, defragmentation may have moved
+		 * the old tuple within the page, invalidating our pointer into the
+		 * buffer.  Re-establish it now that the page is locked again.  The
+		 * tuple's line pointer cannot have been removed or redirected, since
+		 * our xmax keeps the tuple from being pruned away.
+		 */
+		if (tried_eager_prune)
+		{
+			lp = PageGetItemId(page, ItemPointerGetOffsetNumber(&oldtup.t_self));
+			Assert(ItemIdIsNormal(lp));
+			oldtup.t_data = (HeapTupleHeader) PageGetItem(page, lp);
+			oldtup.t_len = ItemIdGetLength(lp);
+		}
 	}
 	else
 	{
@@ -8305,7 +8386,7 @@ heap_index_delete_tuples(Relation rel, TM_IndexDeleteOp *delstate)
 
 			/* Are any tuples from this HOT chain non-vacuumable? */
 			if (heap_hot_search_buffer(&tmp, rel, buf, &SnapshotNonVacuumable,
-									   &heapTuple, NULL, true))
+									   &heapTuple, NULL, NULL, true))
 				continue;		/* can't delete entry */
 
 			/* Caller will delete, since whole HOT chain is vacuumable */
@@ -111,6 +111,13 @@ heapam_index_fetch_end(IndexFetchTableData *scan)
 	pfree(hscan);
 }
 
+/*
+ * When an index fetch has to walk a HOT chain at least this long, try to
+ * prune the page so later lookups are cheaper.  See
+ * heap_page_prune_opt_eager.
+ */
+#define INDEX_FETCH_PRUNE_CHAIN_LENGTH	8
+
 static bool
 heapam_index_fetch_tuple(struct IndexFetchTableData *scan,
 						 ItemPointer tid,
@@ -121,6 +128,7 @@ heapam_index_fetch_tuple(struct IndexFetchTableData *scan,
 	IndexFetchHeapData *hscan = (IndexFetchHeapData *) scan;
 	BufferHeapTupleTableSlot *bslot = (BufferHeapTupleTableSlot *) slot;
 	bool		got_heap_tuple;
+	int			chain_length;
 
 	Assert(TTS_IS_BUFFERTUPLE(slot));
 
@@ -149,6 +157,7 @@ heapam_index_fetch_tuple(struct IndexFetchTableData *scan,
 											snapshot,
 											&bslot->base.tupdata,
 											all_dead,
+											&chain_length,
 											!*call_again);
 	bslot->base.tupdata.t_self = *tid;
 	LockBuffer(hscan->xs_cbuf, BUFFER_LOCK_UNLOCK);
@@ -168,6 +177,15 @@ heapam_index_fetch_tuple(struct IndexFetchTableData *scan,
 	{
 		/* We've reached the end of the HOT chain. */
 		*call_again = false;
+
+		/*
+		 * If we just walked a long chain without finding anything visible,
+		 * try to shorten it so the next lookup is cheaper.  We can't do this
+		 * in the found-tuple case, since the slot would end up referencing
+		 * moved data; there the chain gets cut back once its members die.
+		 */
+		if (chain_length >= INDEX_FETCH_PRUNE_CHAIN_LENGTH)
+			heap_page_prune_opt_eager(hscan->xs_base.rel, hscan->xs_cbuf);
 	}
 
 	return got_heap_tuple;
@@ -2488,6 +2506,14 @@ BitmapHeapScanNextBlock(TableScanDesc scan,
 	hscan->rs_cbuf = read_stream_next_buffer(hscan->rs_read_stream,
 											 &per_buffer_data);
 
+	/*
+	 * Keep the scan descriptor's look-ahead high-water mark up to date, so
+	 * that EXPLAIN can report it even if the scan stops early.
+	 */
+	scan->st.bitmap.rs_maxlookahead =
+		Max(scan->st.bitmap.rs_maxlookahead,
+			read_stream_max_distance(hscan->rs_read_stream));
+
 	if (BufferIsInvalid(hscan->rs_cbuf))
 	{
 		/* the bitmap is exhausted */
@@ -2549,7 +2575,7 @@ BitmapHeapScanNextBlock(TableScanDesc scan,
 
 			ItemPointerSet(&tid, block, offnum);
 			if (heap_hot_search_buffer(&tid, scan->rs_rd, buffer, snapshot,
-									   &heapTuple, NULL, true))
+									   &heapTuple, NULL, NULL, true))
 				hscan->rs_vistuples[ntup++] = ItemPointerGetOffsetNumber(&tid);
 		}
 	}
@@ -674,6 +674,46 @@ heap_xlog_multi_insert(XLogReaderState *record)
 	 */
 	if (action == BLK_NEEDS_REDO && freespace < BLCKSZ / 5)
 		XLogRecordPageWithFreeSpace(rlocator, blkno, freespace);
+
+	/*
+	 * Finally, re-apply the visibility map update that was piggybacked on
+	 * this record.  As in heap_xlog_visible, it's safe to do this even if
+	 * the heap page update was skipped due to the LSN interlock.
+	 */
+	if (xlrec->flags & XLH_INSERT_ALL_FROZEN_SET)
+	{
+		Buffer		vmbuffer = InvalidBuffer;
+
+		if (XLogReadBufferForRedoExtended(record, 1, RBM_ZERO_ON_ERROR, false,
+										  &vmbuffer) == BLK_NEEDS_REDO)
+		{
+			Page		vmpage = BufferGetPage(vmbuffer);
+			Relation	reln;
+
+			/* initialize the page if it was read as zeros */
+			if (PageIsNew(vmpage))
+				PageInit(vmpage, BLCKSZ, 0);
+
+			/*
+			 * XLogReadBufferForRedoExtended locked the buffer. But
+			 * visibilitymap_set will handle locking itself.
+			 */
+			LockBuffer(vmbuffer, BUFFER_LOCK_UNLOCK);
+
+			reln = CreateFakeRelcacheEntry(rlocator);
+			visibilitymap_pin(reln, blkno, &vmbuffer);
+
+			visibilitymap_set(reln, blkno, InvalidBuffer, lsn, vmbuffer,
+							  InvalidTransactionId,
+							  VISIBILITYMAP_ALL_VISIBLE |
+							  VISIBILITYMAP_ALL_FROZEN);
+
+			ReleaseBuffer(vmbuffer);
+			FreeFakeRelcacheEntry(reln);
+		}
+		else if (BufferIsValid(vmbuffer))
+			UnlockReleaseBuffer(vmbuffer);
+	}
 }
 
 /*
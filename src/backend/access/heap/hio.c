@@ -229,10 +229,6 @@ GetVisibilityMapPins(Relation relation, Buffer buffer1, Buffer buffer2,
  * Returns a buffer for a newly extended block. If possible, the buffer is
  * returned exclusively locked. *did_unlock is set to true if the lock had to
  * be released, false otherwise.
- *
- *
- * XXX: It would likely be beneficial for some workloads to extend more
- * aggressively, e.g. using a heuristic based on the relation size.
  */
 static Buffer
 RelationAddBlocks(Relation relation, BulkInsertState bistate,
@@ -300,6 +296,20 @@ RelationAddBlocks(Relation relation, BulkInsertState bistate,
 		if (bistate)
 			extend_by_pages = Max(extend_by_pages, bistate->already_extended_by);
 
+		/*
+		 * For relations that have already grown large, extend more
+		 * aggressively, in proportion to the relation size.  A relation that
+		 * needs to grow again after reaching many thousands of blocks is very
+		 * likely to keep growing, and larger extensions amortize the
+		 * extension lock traffic over more inserts and allow mdzeroextend()
+		 * to preallocate bigger ranges with fallocate().  The cost of
+		 * guessing wrong is low, as the unused pages are entered into the FSM
+		 * (or remembered in the bistate) and get filled by later inserts.
+		 */
+		extend_by_pages = Max(extend_by_pages,
+							  Min(RelationGetNumberOfBlocks(relation) / 128,
+								  MAX_BUFFERS_TO_EXTEND_BY));
+
 		/*
 		 * Can't extend by more than MAX_BUFFERS_TO_EXTEND_BY, we need to pin
 		 * them all concurrently.
@@ -293,6 +293,70 @@ heap_page_prune_opt(Relation relation, Buffer buffer)
 	}
 }
 
+/*
+ * Variant of heap_page_prune_opt for callers that have specific evidence
+ * that pruning this page is worthwhile right now -- e.g. an index fetch had
+ * to walk a long HOT chain, or an UPDATE is about to be driven off the page
+ * for lack of space.
+ *
+ * heap_page_prune_opt only acts when the page is full or short on free
+ * space, so neither situation above would trigger it.  Here we skip the
+ * free-space heuristic and prune whenever there is something removable,
+ * with one restriction: we only touch pages that are already dirty, so that
+ * this eagerness never turns a clean page into a dirty one and thereby
+ * amplifies writes.
+ *
+ * Caller must have pin on the buffer, and must *not* have a lock on it.
+ */
+void
+heap_page_prune_opt_eager(Relation relation, Buffer buffer)
+{
+	Page		page = BufferGetPage(buffer);
+	TransactionId prune_xid;
+	GlobalVisState *vistest;
+
+	/* Can't write WAL in recovery mode; see heap_page_prune_opt */
+	if (RecoveryInProgress())
+		return;
+
+	/* Quick out if there can't be anything to prune */
+	prune_xid = ((PageHeader) page)->pd_prune_xid;
+	if (!TransactionIdIsValid(prune_xid))
+		return;
+
+	vistest = GlobalVisTestFor(relation);
+
+	if (!GlobalVisTestIsRemovableXid(vistest, prune_xid))
+		return;
+
+	/* Try to get exclusive buffer lock; give up if we'd have to wait */
+	if (!ConditionalLockBufferForCleanup(buffer))
+		return;
+
+	/*
+	 * Now that we hold the exclusive lock we can check dirtiness reliably.
+	 * Pruning a page someone else is about to write out anyway is free, so
+	 * that's the only case we handle here.
+	 */
+	if (BufferIsDirty(buffer))
+	{
+		OffsetNumber dummy_off_loc;
+		PruneFreezeResult presult;
+
+		heap_page_prune_and_freeze(relation, buffer, vistest, 0,
+								   NULL, &presult, PRUNE_ON_ACCESS, &dummy_off_loc, NULL, NULL);
+
+		/* Report reclaimed tuples to pgstats; see heap_page_prune_opt */
+		if (presult.ndeleted > presult.nnewlpdead)
+			pgstat_update_heap_dead_tuples(relation,
+										   presult.ndeleted - presult.nnewlpdead);
+	}
+
+	LockBuffer(buffer, BUFFER_LOCK_UNLOCK);
+
+	/* As in heap_page_prune_opt, intentionally no FSM update here */
+}
+
 
 /*
  * Prune and repair fragmentation and potentially freeze tuples on the
@@ -716,6 +780,21 @@ heap_page_prune_and_freeze(Relation relation, Buffer buffer,
 						if (XLogHintBitIsNeeded() && XLogCheckBufferNeedsBackup(buffer))
 							do_freeze = true;
 					}
+
+					/*
+					 * Failing that, freeze anyway if the page looks cold: a
+					 * page LSN older than the redo pointer means nothing has
+					 * modified the page since before the current checkpoint
+					 * cycle began.  The bet is that such a page has gone
+					 * read-only, so freezing it now spares the eventual
+					 * anti-wraparound vacuum from rewriting it long after
+					 * the data went cold.  If the bet is wrong, the next
+					 * modification would have emitted a full-page image
+					 * after the upcoming checkpoint anyway, so we have
+					 * merely paid that cost early.
+					 */
+					if (!do_freeze && XLogCheckBufferNeedsBackup(buffer))
+						do_freeze = true;
 				}
 			}
 		}
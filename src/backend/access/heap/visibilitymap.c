@@ -318,6 +318,51 @@ visibilitymap_set(Relation rel, BlockNumber heapBlk, Buffer heapBuf,
 	return status;
 }
 
+/*
+ *	visibilitymap_set_vmbits - set bit(s) in a pinned and locked map page
+ *
+ * Variant of visibilitymap_set for callers that piggyback the map update on
+ * the WAL record of the heap operation that made the page all-visible,
+ * rather than emitting a separate XLOG_HEAP2_VISIBLE record.  The caller
+ * must hold an exclusive lock on vmBuf, must be inside the critical section
+ * of that operation, and must have registered vmBuf in the record.  Call
+ * this before inserting the record, so that any full-page image taken of
+ * the map page includes the bits; once the record has been inserted, the
+ * caller is responsible for stamping the map page with its LSN.  Replay of
+ * the record is responsible for re-applying this update.
+ */
+void
+visibilitymap_set_vmbits(Relation rel, BlockNumber heapBlk, Buffer vmBuf,
+						 uint8 flags)
+{
+	BlockNumber mapBlock = HEAPBLK_TO_MAPBLOCK(heapBlk);
+	uint32		mapByte = HEAPBLK_TO_MAPBYTE(heapBlk);
+	uint8		mapOffset = HEAPBLK_TO_OFFSET(heapBlk);
+	Page		page;
+	uint8	   *map;
+
+#ifdef TRACE_VISIBILITYMAP
+	elog(DEBUG1, "vm_set_vmbits %s %d", RelationGetRelationName(rel), heapBlk);
+#endif
+
+	Assert(CritSectionCount > 0);
+	Assert(BufferIsExclusiveLocked(vmBuf));
+	Assert((flags & VISIBILITYMAP_VALID_BITS) == flags);
+
+	/* Must never set all_frozen bit without also setting all_visible bit */
+	Assert(flags != VISIBILITYMAP_ALL_FROZEN);
+
+	/* Check that we have the right VM page pinned */
+	if (!BufferIsValid(vmBuf) || BufferGetBlockNumber(vmBuf) != mapBlock)
+		elog(ERROR, "wrong VM buffer passed to visibilitymap_set_vmbits");
+
+	page = BufferGetPage(vmBuf);
+	map = (uint8 *) PageGetContents(page);
+
+	map[mapByte] |= (flags << mapOffset);
+	MarkBufferDirty(vmBuf);
+}
+
 /*
  *	visibilitymap_get_status - get status of bits
  *
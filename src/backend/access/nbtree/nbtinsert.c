@@ -289,27 +289,29 @@ search:
  * all cases (if necessary by creating a new empty root page for caller).
  *
  * The fastpath optimization avoids most of the work of searching the tree
- * repeatedly when a single backend inserts successive new tuples on the
- * rightmost leaf page of an index.  A backend cache of the rightmost leaf
- * page is maintained within _bt_insertonpg(), and used here.  The cache is
- * invalidated here when an insert of a non-pivot tuple must take place on a
- * non-rightmost leaf page.
+ * repeatedly when a single backend inserts successive new tuples on the same
+ * leaf page of an index.  A backend cache of the last leaf page inserted on
+ * is maintained within _bt_insertonpg(), and used here.  The cache is
+ * invalidated here when an insert of a non-pivot tuple must take place on
+ * some other leaf page.
  *
- * The optimization helps with indexes on an auto-incremented field.  It also
- * helps with indexes on datetime columns, as well as indexes with lots of
- * NULL values.  (NULLs usually get inserted in the rightmost page for single
+ * The optimization helps with indexes on an auto-incremented field, where
+ * every insertion lands on the rightmost leaf page.  It equally helps with
+ * bulk loads whose input happens to be ordered on an indexed column, which
+ * dwell on one leaf page at a time, as well as indexes with lots of NULL
+ * values.  (NULLs usually get inserted in the rightmost page for single
  * column indexes, since they usually get treated as coming after everything
  * else in the key space.  Individual NULL tuples will generally be placed on
  * the rightmost leaf page due to the influence of the heap TID column.)
  *
  * Note that we avoid applying the optimization when there is insufficient
- * space on the rightmost page to fit caller's new item.  This is necessary
+ * space on the cached page to fit caller's new item.  This is necessary
  * because we'll need to return a real descent stack when a page split is
  * expected (actually, caller can cope with a leaf page split that uses a NULL
  * stack, but that's very slow and so must be avoided).  Note also that the
  * fastpath optimization acquires the lock on the page conditionally as a way
  * of reducing extra contention when there are concurrent insertions into the
- * rightmost page (we give up if we'd have to wait for the lock).  We assume
+ * cached page (we give up if we'd have to wait for the lock).  We assume
  * that it isn't useful to apply the optimization when there is contention,
  * since each per-backend cache won't stay valid for long.
  */
@@ -334,25 +336,33 @@ _bt_search_insert(Relation rel, Relation heaprel, BTInsertState insertstate)
 			opaque = BTPageGetOpaque(page);
 
 			/*
-			 * Check if the page is still the rightmost leaf page and has
-			 * enough free space to accommodate the new tuple.  Also check
-			 * that the insertion scan key is strictly greater than the first
-			 * non-pivot tuple on the page.  (Note that we expect itup_key's
-			 * scantid to be unset when our caller is a checkingunique
-			 * inserter.)
+			 * Check if the page is still a live leaf page with enough free
+			 * space to accommodate the new tuple.  The insertion scan key
+			 * must be strictly greater than the first non-pivot tuple on the
+			 * page, which guarantees that no tuple the new one must go
+			 * before (or be checked for uniqueness against) can exist on an
+			 * earlier page.  On a non-rightmost page it must also be
+			 * strictly less than the page's high key on some key attribute,
+			 * which guarantees that _bt_findinsertloc can never need to move
+			 * right -- not even after a checkingunique caller restores the
+			 * scan key's scantid.  (Note that we expect itup_key's scantid
+			 * to be unset when our caller is a checkingunique inserter.)
 			 */
-			if (P_RIGHTMOST(opaque) &&
-				P_ISLEAF(opaque) &&
+			if (P_ISLEAF(opaque) &&
 				!P_IGNORE(opaque) &&
 				PageGetFreeSpace(page) > insertstate->itemsz &&
-				PageGetMaxOffsetNumber(page) >= P_HIKEY &&
-				_bt_compare(rel, insertstate->itup_key, page, P_HIKEY) > 0)
+				PageGetMaxOffsetNumber(page) >= P_FIRSTDATAKEY(opaque) &&
+				_bt_compare(rel, insertstate->itup_key, page,
+							P_FIRSTDATAKEY(opaque)) > 0 &&
+				(P_RIGHTMOST(opaque) ||
+				 _bt_compare(rel, insertstate->itup_key, page, P_HIKEY) < 0))
 			{
 				/*
 				 * Caller can use the fastpath optimization because cached
-				 * block is still rightmost leaf page, which can fit caller's
-				 * new tuple without splitting.  Keep block in local cache for
-				 * next insert, and have caller use NULL stack.
+				 * block is still the leaf page the new tuple belongs on, and
+				 * it can fit caller's new tuple without splitting.  Keep
+				 * block in local cache for next insert, and have caller use
+				 * NULL stack.
 				 *
 				 * Note that _bt_insert_parent() has an assertion that catches
 				 * leaf page splits that somehow follow from a fastpath insert
@@ -1118,7 +1128,6 @@ _bt_insertonpg(Relation rel,
 	BTPageOpaque opaque;
 	bool		isleaf,
 				isroot,
-				isrightmost,
 				isonly;
 	IndexTuple	oposting = NULL;
 	IndexTuple	origitup = NULL;
@@ -1128,7 +1137,6 @@ _bt_insertonpg(Relation rel,
 	opaque = BTPageGetOpaque(page);
 	isleaf = P_ISLEAF(opaque);
 	isroot = P_ISROOT(opaque);
-	isrightmost = P_RIGHTMOST(opaque);
 	isonly = P_LEFTMOST(opaque) && P_RIGHTMOST(opaque);
 
 	/* child buffer must be given iff inserting on an internal page */
@@ -1405,11 +1413,14 @@ _bt_insertonpg(Relation rel,
 			_bt_relbuf(rel, cbuf);
 
 		/*
-		 * Cache the block number if this is the rightmost leaf page.  Cache
-		 * may be used by a future inserter within _bt_search_insert().
+		 * Cache the block number if this is a leaf page.  Cache may be used
+		 * by a future inserter within _bt_search_insert(), whether the next
+		 * tuple belongs here because keys arrive in increasing order
+		 * (rightmost page) or because a bulk load presents them in sorted
+		 * runs that dwell on one leaf page at a time.
 		 */
 		blockcache = InvalidBlockNumber;
-		if (isrightmost && isleaf && !isroot)
+		if (isleaf && !isroot)
 			blockcache = BufferGetBlockNumber(buf);
 
 		/* Release buffer for insertion target block */
@@ -20,9 +20,11 @@
 #include "access/xact.h"
 #include "miscadmin.h"
 #include "pgstat.h"
+#include "storage/bufmgr.h"
 #include "storage/predicate.h"
 #include "utils/lsyscache.h"
 #include "utils/rel.h"
+#include "utils/spccache.h"
 
 
 static inline void _bt_drop_lock_and_maybe_pin(Relation rel, BTScanOpaque so);
@@ -32,6 +34,9 @@ static Buffer _bt_moveright(Relation rel, Relation heaprel, BTScanInsert key,
 static OffsetNumber _bt_binsrch(Relation rel, BTScanInsert key, Buffer buf);
 static int	_bt_binsrch_posting(BTScanInsert key, Page page,
 								OffsetNumber offnum);
+static int32 _bt_compare_prefix(Relation rel, BTScanInsert key, Page page,
+								OffsetNumber offnum, int prefix,
+								int *equalatts);
 static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir,
 						 OffsetNumber offnum, bool firstpage);
 static void _bt_saveitem(BTScanOpaque so, int itemIndex,
@@ -82,6 +87,68 @@ _bt_drop_lock_and_maybe_pin(Relation rel, BTScanOpaque so)
 	so->currPos.buf = InvalidBuffer;
 }
 
+/*
+ *	_bt_prefetch_heap() -- hint upcoming heap accesses to the storage layer.
+ *
+ * Once a leaf page has been read, every heap TID the scan will return from
+ * it is known, while the caller will fetch the heap tuples one at a time.
+ * Issue prefetch requests for the heap blocks in the order they will be
+ * consumed, limited to the heap tablespace's effective_io_concurrency
+ * distinct blocks.  Runs of TIDs on the same block (common with clustered
+ * data) issue only one request.
+ *
+ * Called without the leaf buffer lock, so the requests don't lengthen the
+ * lock hold time.  Not used for index-only scans, where most heap fetches
+ * are avoided entirely.
+ */
+static void
+_bt_prefetch_heap(IndexScanDesc scan, ScanDirection dir)
+{
+#ifdef USE_PREFETCH
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	BlockNumber lastblkno = InvalidBlockNumber;
+	int			distance;
+
+	if (scan->heapRelation == NULL || scan->xs_want_itup)
+		return;
+
+	distance = get_tablespace_io_concurrency(scan->heapRelation->rd_rel->reltablespace);
+
+	if (ScanDirectionIsForward(dir))
+	{
+		for (int i = so->currPos.firstItem;
+			 i <= so->currPos.lastItem && distance > 0; i++)
+		{
+			BlockNumber blkno =
+				ItemPointerGetBlockNumber(&so->currPos.items[i].heapTid);
+
+			if (blkno != lastblkno)
+			{
+				PrefetchBuffer(scan->heapRelation, MAIN_FORKNUM, blkno);
+				lastblkno = blkno;
+				distance--;
+			}
+		}
+	}
+	else
+	{
+		for (int i = so->currPos.lastItem;
+			 i >= so->currPos.firstItem && distance > 0; i--)
+		{
+			BlockNumber blkno =
+				ItemPointerGetBlockNumber(&so->currPos.items[i].heapTid);
+
+			if (blkno != lastblkno)
+			{
+				PrefetchBuffer(scan->heapRelation, MAIN_FORKNUM, blkno);
+				lastblkno = blkno;
+				distance--;
+			}
+		}
+	}
+#endif							/* USE_PREFETCH */
+}
+
 /*
  *	_bt_search() -- Search the tree for a particular scankey,
  *		or more precisely for the first leaf page it could be on.
@@ -355,6 +422,9 @@ _bt_binsrch(Relation rel,
 				high;
 	int32		result,
 				cmpval;
+	int			lowprefix = 0,
+				highprefix = 0,
+				equalatts;
 
 	page = BufferGetPage(buf);
 	opaque = BTPageGetOpaque(page);
@@ -393,18 +463,34 @@ _bt_binsrch(Relation rel,
 
 	cmpval = key->nextkey ? 0 : 1;	/* select comparison value */
 
+	/*
+	 * As the search range narrows, we track how many leading scankey
+	 * attributes compared equal against the tuples currently bounding it.
+	 * Every tuple in between must share the smaller of the two prefixes
+	 * with the scankey, so further comparisons can skip those attributes
+	 * ("dynamic prefix truncation").  This greatly reduces the comparison
+	 * work on pages full of tuples with equal leading attributes, which is
+	 * typical for multi-column indexes.
+	 */
 	while (high > low)
 	{
 		OffsetNumber mid = low + ((high - low) / 2);
 
 		/* We have low <= mid < high, so mid points at a real slot */
 
-		result = _bt_compare(rel, key, page, mid);
+		result = _bt_compare_prefix(rel, key, page, mid,
+									Min(lowprefix, highprefix), &equalatts);
 
 		if (result >= cmpval)
+		{
 			low = mid + 1;
+			lowprefix = equalatts;
+		}
 		else
+		{
 			high = mid;
+			highprefix = equalatts;
+		}
 	}
 
 	/*
@@ -486,6 +572,9 @@ _bt_binsrch_insert(Relation rel, BTInsertState insertstate)
 				stricthigh;
 	int32		result,
 				cmpval;
+	int			lowprefix = 0,
+				highprefix = 0,
+				equalatts;
 
 	page = BufferGetPage(insertstate->buf);
 	opaque = BTPageGetOpaque(page);
@@ -533,19 +622,25 @@ _bt_binsrch_insert(Relation rel, BTInsertState insertstate)
 
 	cmpval = 1;					/* !nextkey comparison value */
 
+	/* Skip scankey attributes known equal from both bounds; see _bt_binsrch */
 	while (high > low)
 	{
 		OffsetNumber mid = low + ((high - low) / 2);
 
 		/* We have low <= mid < high, so mid points at a real slot */
 
-		result = _bt_compare(rel, key, page, mid);
+		result = _bt_compare_prefix(rel, key, page, mid,
+									Min(lowprefix, highprefix), &equalatts);
 
 		if (result >= cmpval)
+		{
 			low = mid + 1;
+			lowprefix = equalatts;
+		}
 		else
 		{
 			high = mid;
+			highprefix = equalatts;
 			if (result != 0)
 				stricthigh = high;
 		}
@@ -663,15 +758,29 @@ _bt_binsrch_posting(BTScanInsert key, Page page, OffsetNumber offnum)
 }
 
 /*----------
- *	_bt_compare() -- Compare insertion-type scankey to tuple on a page.
+ *	_bt_compare_prefix() -- Compare insertion-type scankey to tuple on a page,
+ *			skipping a prefix of attributes known to be equal.
  *
  *	page/offnum: location of btree item to be compared to.
+ *	prefix: number of leading key attributes the caller has already
+ *		established to be equal between the scankey and this tuple.
+ *	equalatts: output; set to the number of leading key attributes that are
+ *		equal between the scankey and this tuple.
  *
  *		This routine returns:
  *			<0 if scankey < tuple at offnum;
  *			 0 if scankey == tuple at offnum;
  *			>0 if scankey > tuple at offnum.
  *
+ * The prefix argument implements "dynamic prefix truncation" for binary
+ * searches: with a page's tuples sandwiched between a lower and an upper
+ * bound tuple, any tuple in between must share with the scankey every
+ * leading attribute that both bounds share with it, so those attributes
+ * need not be compared again.  Passing a nonzero prefix is only safe when
+ * the caller has verified equality against tuples on *this* page, ordered
+ * around offnum, while continuously holding a lock on the page; zero is
+ * always safe.
+ *
  * NULLs in the keys are treated as sortable values.  Therefore
  * "equality" does not necessarily mean that the item should be returned
  * to the caller as a matching key.  Similarly, an insertion scankey
@@ -689,11 +798,13 @@ _bt_binsrch_posting(BTScanInsert key, Page page, OffsetNumber offnum)
  * key.  See backend/access/nbtree/README for details.
  *----------
  */
-int32
-_bt_compare(Relation rel,
-			BTScanInsert key,
-			Page page,
-			OffsetNumber offnum)
+static int32
+_bt_compare_prefix(Relation rel,
+				   BTScanInsert key,
+				   Page page,
+				   OffsetNumber offnum,
+				   int prefix,
+				   int *equalatts)
 {
 	TupleDesc	itupdesc = RelationGetDescr(rel);
 	BTPageOpaque opaque = BTPageGetOpaque(page);
@@ -707,13 +818,17 @@ _bt_compare(Relation rel,
 	Assert(_bt_check_natts(rel, key->heapkeyspace, page, offnum));
 	Assert(key->keysz <= IndexRelationGetNumberOfKeyAttributes(rel));
 	Assert(key->heapkeyspace || key->scantid == NULL);
+	Assert(prefix >= 0 && prefix <= key->keysz);
 
 	/*
 	 * Force result ">" if target item is first data item on an internal page
 	 * --- see NOTE above.
 	 */
 	if (!P_ISLEAF(opaque) && offnum == P_FIRSTDATAKEY(opaque))
+	{
+		*equalatts = 0;
 		return 1;
+	}
 
 	itup = (IndexTuple) PageGetItem(page, PageGetItemId(page, offnum));
 	ntupatts = BTreeTupleGetNAtts(itup, rel);
@@ -733,8 +848,8 @@ _bt_compare(Relation rel,
 	ncmpkey = Min(ntupatts, key->keysz);
 	Assert(key->heapkeyspace || ncmpkey == key->keysz);
 	Assert(!BTreeTupleIsPosting(itup) || key->allequalimage);
-	scankey = key->scankeys;
-	for (int i = 1; i <= ncmpkey; i++)
+	scankey = key->scankeys + prefix;
+	for (int i = prefix + 1; i <= ncmpkey; i++)
 	{
 		Datum		datum;
 		bool		isNull;
@@ -778,11 +893,21 @@ _bt_compare(Relation rel,
 
 		/* if the keys are unequal, return the difference */
 		if (result != 0)
+		{
+			*equalatts = i - 1;
 			return result;
+		}
 
 		scankey++;
 	}
 
+	/*
+	 * All of the tuple's stored key attributes compared equal (a pivot tuple
+	 * truncated to fewer attributes than the skipped prefix is only known to
+	 * be equal on the attributes it still has; any further ones are -inf).
+	 */
+	*equalatts = ncmpkey;
+
 	/*
 	 * All non-truncated attributes (other than heap TID) were found to be
 	 * equal.  Treat truncated attributes as minus infinity when scankey has a
@@ -863,6 +988,23 @@ _bt_compare(Relation rel,
 	return 0;
 }
 
+/*
+ *	_bt_compare() -- Compare insertion-type scankey to tuple on a page.
+ *
+ * Convenience wrapper around _bt_compare_prefix() for callers that have no
+ * prior knowledge about the tuple; see above for the comparison rules.
+ */
+int32
+_bt_compare(Relation rel,
+			BTScanInsert key,
+			Page page,
+			OffsetNumber offnum)
+{
+	int			equalatts;
+
+	return _bt_compare_prefix(rel, key, page, offnum, 0, &equalatts);
+}
+
 /*
  *	_bt_first() -- Find the first item in a scan.
  *
@@ -2308,6 +2450,7 @@ _bt_readfirstpage(IndexScanDesc scan, OffsetNumber offnum, ScanDirection dir)
 		 */
 		Assert(BTScanPosIsPinned(so->currPos));
 		_bt_drop_lock_and_maybe_pin(rel, so);
+		_bt_prefetch_heap(scan, dir);
 		return true;
 	}
 
@@ -2468,6 +2611,7 @@ _bt_readnextpage(IndexScanDesc scan, BlockNumber blkno,
 	Assert(so->currPos.currPage == blkno);
 	Assert(BTScanPosIsPinned(so->currPos));
 	_bt_drop_lock_and_maybe_pin(rel, so);
+	_bt_prefetch_heap(scan, dir);
 
 	return true;
 }
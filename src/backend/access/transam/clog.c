@@ -58,11 +58,14 @@
  * and page numbers in TruncateCLOG (see CLOGPagePrecedes).
  */
 
-/* We need two bits per xact, so four xacts fit in a byte */
-#define CLOG_BITS_PER_XACT	2
-#define CLOG_XACTS_PER_BYTE 4
+/*
+ * CLOG_BITS_PER_XACT and friends live in clog.h so that the chunk layout
+ * used by TransactionIdGetStatusChunk is visible to its callers.
+ */
 #define CLOG_XACTS_PER_PAGE (BLCKSZ * CLOG_XACTS_PER_BYTE)
-#define CLOG_XACT_BITMASK	((1 << CLOG_BITS_PER_XACT) - 1)
+
+StaticAssertDecl(CLOG_XACTS_PER_PAGE % CLOG_STATUS_CHUNK_XACTS == 0,
+				 "clog status chunks must evenly divide clog pages");
 
 /*
  * Because space used in CLOG by each transaction is so small, we place a
@@ -88,8 +91,10 @@ TransactionIdToPage(TransactionId xid)
 #define TransactionIdToByte(xid)	(TransactionIdToPgIndex(xid) / CLOG_XACTS_PER_BYTE)
 #define TransactionIdToBIndex(xid)	((xid) % (TransactionId) CLOG_XACTS_PER_BYTE)
 
-/* We store the latest async LSN for each group of transactions */
-#define CLOG_XACTS_PER_LSN_GROUP	32	/* keep this a power of 2 */
+/*
+ * We store the latest async LSN for each group of transactions; the group
+ * size, CLOG_XACTS_PER_LSN_GROUP, is defined in clog.h.
+ */
 #define CLOG_LSNS_PER_PAGE	(CLOG_XACTS_PER_PAGE / CLOG_XACTS_PER_LSN_GROUP)
 
 #define GetLSNIndex(slotno, xid)	((slotno) * CLOG_LSNS_PER_PAGE + \
@@ -755,6 +760,60 @@ TransactionIdGetStatus(TransactionId xid, XLogRecPtr *lsn)
 	return status;
 }
 
+/*
+ * TransactionIdGetStatusChunk
+ *
+ * Like TransactionIdGetStatus, but while we hold the bank lock, also copy
+ * out the aligned chunk of clog data containing xid, so that transam.c can
+ * answer nearby lookups from a backend-local cache.  *chunkstart receives
+ * the first XID the chunk covers.
+ *
+ * NB: bits that read as in-progress or sub-committed in the copy may have
+ * changed in shared memory by the time the caller looks at them, so only
+ * committed and aborted bits in the copy are authoritative.  Likewise, the
+ * copied group LSNs are only guaranteed "late enough" (in the sense
+ * described above) for transactions whose copied status is final, since a
+ * group's LSN can advance when another of its transactions later commits.
+ */
+XidStatus
+TransactionIdGetStatusChunk(TransactionId xid, XLogRecPtr *lsn,
+							TransactionId *chunkstart, ClogStatusChunk *chunk)
+{
+	int64		pageno = TransactionIdToPage(xid);
+	int			byteno = TransactionIdToByte(xid);
+	int			bshift = TransactionIdToBIndex(xid) * CLOG_BITS_PER_XACT;
+	int			chunkbyte = byteno - (byteno % CLOG_STATUS_CHUNK_BYTES);
+	int			slotno;
+	int			lsnindex;
+	char	   *byteptr;
+	XidStatus	status;
+
+	/* lock is acquired by SimpleLruReadPage_ReadOnly */
+
+	slotno = SimpleLruReadPage_ReadOnly(XactCtl, pageno, xid);
+	byteptr = XactCtl->shared->page_buffer[slotno] + byteno;
+
+	status = (*byteptr >> bshift) & CLOG_XACT_BITMASK;
+
+	lsnindex = GetLSNIndex(slotno, xid);
+	*lsn = XactCtl->shared->group_lsn[lsnindex];
+
+	memcpy(chunk->bytes,
+		   XactCtl->shared->page_buffer[slotno] + chunkbyte,
+		   CLOG_STATUS_CHUNK_BYTES);
+	memcpy(chunk->group_lsn,
+		   &XactCtl->shared->group_lsn[slotno * CLOG_LSNS_PER_PAGE +
+									   chunkbyte * CLOG_XACTS_PER_BYTE / CLOG_XACTS_PER_LSN_GROUP],
+		   sizeof(chunk->group_lsn));
+
+	LWLockRelease(SimpleLruGetBankLock(XactCtl, pageno));
+
+	*chunkstart = (xid - TransactionIdToPgIndex(xid)) +
+		(TransactionId) chunkbyte * CLOG_XACTS_PER_BYTE;
+
+	return status;
+}
+
 /*
  * Number of shared CLOG buffers.
  *
@@ -1201,6 +1201,9 @@ SlruSelectLRUPage(SlruCtl ctl, int64 pageno)
 		int			bestvalidslot = 0;	/* keep compiler quiet */
 		int			best_valid_delta = -1;
 		int64		best_valid_page_number = 0; /* keep compiler quiet */
+		int			bestcleanslot = 0;	/* keep compiler quiet */
+		int			best_clean_delta = -1;
+		int64		best_clean_page_number = 0; /* keep compiler quiet */
 		int			bestinvalidslot = 0;	/* keep compiler quiet */
 		int			best_invalid_delta = -1;
 		int64		best_invalid_page_number = 0;	/* keep compiler quiet */
@@ -1289,6 +1292,18 @@ SlruSelectLRUPage(SlruCtl ctl, int64 pageno)
 					best_valid_delta = this_delta;
 					best_valid_page_number = this_page_number;
 				}
+
+				/* Separately track the best clean page, see below */
+				if (!shared->page_dirty[slotno] &&
+					(this_delta > best_clean_delta ||
+					 (this_delta == best_clean_delta &&
+					  ctl->PagePrecedes(this_page_number,
+										best_clean_page_number))))
+				{
+					bestcleanslot = slotno;
+					best_clean_delta = this_delta;
+					best_clean_page_number = this_page_number;
+				}
 			}
 			else
 			{
@@ -1323,6 +1338,19 @@ SlruSelectLRUPage(SlruCtl ctl, int64 pageno)
 		if (!shared->page_dirty[bestvalidslot])
 			return bestvalidslot;
 
+		/*
+		 * The least recently used page is dirty, and evicting it here means
+		 * writing it out synchronously while holding the bank lock.  If
+		 * there is a clean page that is at least half as far back in the LRU
+		 * order, settle for that one instead and leave the dirty page for
+		 * the next SimpleLruWriteAll() cycle to clean in bulk.  The cutoff
+		 * keeps us from sacrificing recently-used clean pages just because a
+		 * long-dirty page lingers between checkpoints.
+		 */
+		if (best_clean_delta >= 0 &&
+			best_clean_delta >= best_valid_delta / 2)
+			return bestcleanslot;
+
 		/*
 		 * Write the page.
 		 */
@@ -34,6 +34,20 @@ static TransactionId cachedFetchXid = InvalidTransactionId;
 static XidStatus cachedFetchXidStatus;
 static XLogRecPtr cachedCommitLSN;
 
+/*
+ * We also keep a backend-local copy of the chunk of clog data surrounding
+ * the last XID we had to look up in shared memory.  Scans of tables touched
+ * by many different transactions probe XIDs that are heavily clustered, and
+ * every probe that misses the single-item cache above would otherwise have
+ * to take a clog bank lock.  Because a transaction's status never changes
+ * once it is committed or aborted, those bits in the copy stay valid
+ * indefinitely and the copy never needs invalidating; in-progress and
+ * sub-committed bits may be stale, so lookups that find them fall through
+ * to a fresh fetch.
+ */
+static TransactionId cachedStatusChunkStart = InvalidTransactionId;
+static ClogStatusChunk cachedStatusChunk;
+
 /* Local functions */
 static XidStatus TransactionLogFetch(TransactionId transactionId);
 
@@ -74,9 +88,35 @@ TransactionLogFetch(TransactionId transactionId)
 	}
 
 	/*
-	 * Get the transaction status.
+	 * Next, see whether the backend-local chunk copy covers this XID and
+	 * already has a final answer for it.  (If the copied bits say
+	 * in-progress or sub-committed, they may be out of date, so we must ask
+	 * shared memory.)  The unsigned subtraction also rejects XIDs preceding
+	 * the chunk start.
+	 */
+	if (TransactionIdIsValid(cachedStatusChunkStart) &&
+		transactionId - cachedStatusChunkStart < CLOG_STATUS_CHUNK_XACTS)
+	{
+		xidstatus = ClogStatusChunkGetStatus(&cachedStatusChunk,
+											 transactionId - cachedStatusChunkStart,
+											 &xidlsn);
+		if (xidstatus == TRANSACTION_STATUS_COMMITTED ||
+			xidstatus == TRANSACTION_STATUS_ABORTED)
+		{
+			cachedFetchXid = transactionId;
+			cachedFetchXidStatus = xidstatus;
+			cachedCommitLSN = xidlsn;
+			return xidstatus;
+		}
+	}
+
+	/*
+	 * Get the transaction status, refilling the chunk copy while the clog
+	 * bank lock is held anyway.
 	 */
-	xidstatus = TransactionIdGetStatus(transactionId, &xidlsn);
+	xidstatus = TransactionIdGetStatusChunk(transactionId, &xidlsn,
+											&cachedStatusChunkStart,
+											&cachedStatusChunk);
 
 	/*
 	 * Cache it, but DO NOT cache status for unfinished or sub-committed
@@ -480,6 +480,7 @@ MarkAsPreparingGuts(GlobalTransaction gxact, FullTransactionId fxid,
 	/* subxid data must be filled later by GXactLoadSubxactData */
 	proc->subxidStatus.overflowed = false;
 	proc->subxidStatus.count = 0;
+	SubxidFilterReset(&proc->subxidsFilter);
 
 	gxact->prepared_at = prepared_at;
 	gxact->fxid = fxid;
@@ -510,6 +511,14 @@ GXactLoadSubxactData(GlobalTransaction gxact, int nsubxacts,
 	PGPROC	   *proc = GetPGProcByNumber(gxact->pgprocno);
 
 	/* We need no extra lock since the GXACT isn't valid yet */
+
+	/*
+	 * The filter must cover every subxact, including any that don't fit in
+	 * the cache below, so fill it before truncating nsubxacts.
+	 */
+	for (int i = 0; i < nsubxacts; i++)
+		SubxidFilterAdd(&proc->subxidsFilter, children[i]);
+
 	if (nsubxacts > PGPROC_MAX_CACHED_SUBXIDS)
 	{
 		proc->subxidStatus.overflowed = true;
@@ -266,6 +266,15 @@ GetNewTransactionId(bool isSubXact)
 		Assert(substat->count == MyProc->subxidStatus.count);
 		Assert(substat->overflowed == MyProc->subxidStatus.overflowed);
 
+		/*
+		 * Remember the subxid in our Bloom filter whether or not it fits in
+		 * the cache, so that snapshots taken after the cache overflows can
+		 * rule out most non-subxact XIDs without consulting pg_subtrans.
+		 * Snapshots that miss this update are fine: the XID is >= their
+		 * xmax, so they never probe the filter for it.
+		 */
+		SubxidFilterAdd(&MyProc->subxidsFilter, xid);
+
 		if (nxids < PGPROC_MAX_CACHED_SUBXIDS)
 		{
 			MyProc->subxids.xids[nxids] = xid;
@@ -123,6 +123,7 @@ bool		EnableHotStandby = false;
 bool		fullPageWrites = true;
 bool		wal_log_hints = false;
 int			wal_compression = WAL_COMPRESSION_NONE;
+int			wal_compression_level = 3;
 char	   *wal_consistency_checking_string = NULL;
 bool	   *wal_consistency_checking = NULL;
 bool		wal_init_zero = true;
@@ -467,6 +468,13 @@ typedef struct XLogCtlData
 	pg_atomic_uint64 logWriteResult;	/* last byte + 1 written out */
 	pg_atomic_uint64 logFlushResult;	/* last byte + 1 flushed */
 
+	/*
+	 * Moving average of recent WAL sync times, in microseconds.  Maintained
+	 * by whoever performs the sync in issue_xlog_fsync(); used by XLogFlush()
+	 * to bound the group commit delay.  Zero until the first sync.
+	 */
+	pg_atomic_uint64 avgSyncMicros;
+
 	/*
 	 * First initialized page in the cache (first byte position).
 	 */
@@ -3010,11 +3018,23 @@ XLogFlush(XLogRecPtr record)
 		 *
 		 * We do not sleep if enableFsync is not turned on, nor if there are
 		 * fewer than CommitSiblings other backends with active transactions.
+		 *
+		 * commit_delay gives the upper bound of the sleep, but sleeping for
+		 * longer than the sync itself takes can only add latency, never
+		 * throughput, so the delay is additionally capped at half of the
+		 * recent average WAL sync time.  That way a commit_delay tuned for a
+		 * busy period, or for slower storage, does not create convoys once
+		 * the device turns out to be fast.
 		 */
 		if (CommitDelay > 0 && enableFsync &&
 			MinimumActiveBackends(CommitSiblings))
 		{
-			pg_usleep(CommitDelay);
+			long		delay = CommitDelay;
+			uint64		synctime = pg_atomic_read_u64(&XLogCtl->avgSyncMicros);
+
+			if (synctime > 0)
+				delay = Min(delay, (long) (synctime / 2));
+			pg_usleep(delay);
 
 			/*
 			 * Re-check how far we can now flush the WAL. It's generally not
@@ -3150,6 +3170,13 @@ XLogBackgroundFlush(void)
 				XLogFileClose();
 			}
 		}
+
+		/*
+		 * Even with nothing to flush (e.g. when synchronously committing
+		 * backends flush their own WAL), keep the next segment preallocated;
+		 * see the corresponding call below.
+		 */
+		PreallocXlogFiles(GetXLogInsertRecPtr(), insertTLI);
 		return false;
 	}
 
@@ -3226,6 +3253,18 @@ XLogBackgroundFlush(void)
 	 */
 	AdvanceXLInsertBuffer(InvalidXLogRecPtr, insertTLI, true);
 
+	/*
+	 * Similarly, take WAL segment creation off the critical path.  Segments
+	 * recycled at checkpoints normally provide a pool of future segments,
+	 * but when WAL volume outgrows that pool the backend that crosses the
+	 * segment boundary has to create and zero the next file itself, a
+	 * multi-ms stall at commit time.  Once the insert position enters the
+	 * tail of the current segment, create the next one here instead.  At
+	 * high WAL generation rates we pass through here at least once per
+	 * segment, so this keeps pace with demand automatically.
+	 */
+	PreallocXlogFiles(GetXLogInsertRecPtr(), insertTLI);
+
 	/*
 	 * If we determined that we need to write data, but somebody else
 	 * wrote/flushed already, it should be considered as being active, to
@@ -5193,6 +5232,7 @@ XLOGShmemInit(void)
 	pg_atomic_init_u64(&XLogCtl->logInsertResult, InvalidXLogRecPtr);
 	pg_atomic_init_u64(&XLogCtl->logWriteResult, InvalidXLogRecPtr);
 	pg_atomic_init_u64(&XLogCtl->logFlushResult, InvalidXLogRecPtr);
+	pg_atomic_init_u64(&XLogCtl->avgSyncMicros, 0);
 	pg_atomic_init_u64(&XLogCtl->unloggedLSN, InvalidXLogRecPtr);
 
 	pg_atomic_init_u64(&XLogCtl->InitializeReserved, InvalidXLogRecPtr);
@@ -8851,6 +8891,10 @@ issue_xlog_fsync(int fd, XLogSegNo segno, TimeLineID tli)
 {
 	char	   *msg = NULL;
 	instr_time	start;
+	instr_time	sync_start;
+	instr_time	sync_end;
+	uint64		elapsed;
+	uint64		avg;
 
 	Assert(tli != 0);
 
@@ -8868,6 +8912,13 @@ issue_xlog_fsync(int fd, XLogSegNo segno, TimeLineID tli)
 	 */
 	start = pgstat_prepare_io_time(track_wal_io_timing);
 
+	/*
+	 * Also time the sync for the group commit delay heuristic in XLogFlush().
+	 * This is measured separately because it's needed whether or not WAL I/O
+	 * timing is being tracked, and it's cheap next to the sync itself.
+	 */
+	INSTR_TIME_SET_CURRENT(sync_start);
+
 	pgstat_report_wait_start(WAIT_EVENT_WAL_SYNC);
 	switch (wal_sync_method)
 	{
@@ -8912,6 +8963,14 @@ issue_xlog_fsync(int fd, XLogSegNo segno, TimeLineID tli)
 
 	pgstat_report_wait_end();
 
+	/* Fold this sync into the moving average of recent sync times. */
+	INSTR_TIME_SET_CURRENT(sync_end);
+	INSTR_TIME_SUBTRACT(sync_end, sync_start);
+	elapsed = INSTR_TIME_GET_MICROSEC(sync_end);
+	avg = pg_atomic_read_u64(&XLogCtl->avgSyncMicros);
+	avg = (avg > 0) ? (avg * 3 + elapsed) / 4 : elapsed;
+	pg_atomic_write_u64(&XLogCtl->avgSyncMicros, avg);
+
 	pgstat_count_io_op_time(IOOBJECT_WAL, IOCONTEXT_NORMAL, IOOP_FSYNC,
 							start, 1, 0);
 }
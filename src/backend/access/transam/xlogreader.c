@@ -826,17 +826,20 @@ restart:
 			 */
 			if (total_len > state->readRecordBufSize)
 			{
-				char		save_copy[XLOG_BLCKSZ * 2];
+				char	   *oldbuf = state->readRecordBuf;
 
 				/*
-				 * Save and restore the data we already had.  It can't be more
-				 * than two pages.
+				 * Carry the data we already had (no more than two pages)
+				 * straight into the new buffer, rather than bouncing it
+				 * through a temporary copy.  allocate_recordbuf would free
+				 * the old buffer before we could read from it, so detach it
+				 * first and free it ourselves.
 				 */
-				Assert(gotlen <= lengthof(save_copy));
 				Assert(gotlen <= state->readRecordBufSize);
-				memcpy(save_copy, state->readRecordBuf, gotlen);
+				state->readRecordBuf = NULL;
 				allocate_recordbuf(state, total_len);
-				memcpy(state->readRecordBuf, save_copy, gotlen);
+				memcpy(state->readRecordBuf, oldbuf, gotlen);
+				pfree(oldbuf);
 				buffer = state->readRecordBuf + gotlen;
 			}
 		} while (gotlen < total_len);
@@ -1709,6 +1709,7 @@ sendFile(bbsink *sink, const char *readfilename, const char *tarfilename,
 		else
 		{
 			BlockNumber relative_blkno;
+			unsigned	nblocks = 1;
 
 			/*
 			 * If we've read all the blocks, then it's time to stop.
@@ -1717,13 +1718,22 @@ sendFile(bbsink *sink, const char *readfilename, const char *tarfilename,
 				break;
 
 			/*
-			 * Read just one block, whichever one is the next that we're
-			 * supposed to include.
+			 * Read the next block that we're supposed to include.  Runs of
+			 * consecutive blocks are common (bulk loads dirty relations
+			 * sequentially), so coalesce as many immediately following
+			 * blocks as the buffer can hold into one read.
 			 */
 			relative_blkno = incremental_blocks[ibindex++];
+			while (ibindex < num_incremental_blocks &&
+				   incremental_blocks[ibindex] == relative_blkno + nblocks &&
+				   (nblocks + 1) * (Size) BLCKSZ <= sink->bbs_buffer_length)
+			{
+				nblocks++;
+				ibindex++;
+			}
 			cnt = read_file_data_into_buffer(sink, readfilename, fd,
-											 relative_blkno * BLCKSZ,
-											 BLCKSZ,
+											 relative_blkno * (off_t) BLCKSZ,
+											 nblocks * BLCKSZ,
 											 relative_blkno + segno * RELSEG_SIZE,
 											 verify_checksum,
 											 &checksum_failures);
@@ -1735,12 +1745,18 @@ sendFile(bbsink *sink, const char *readfilename, const char *tarfilename,
 			 * relation files, but we might transiently observe an
 			 * intermediate value.
 			 *
-			 * It should be fine to treat this just as if the entire block had
-			 * been truncated away - i.e. fill this and all later blocks with
-			 * zeroes. WAL replay will fix things up.
+			 * It should be fine to treat this just as if the affected and
+			 * all later blocks had been truncated away - i.e. fill them with
+			 * zeroes. WAL replay will fix things up.  Keep any whole blocks
+			 * we did read, and stop after archiving them.
 			 */
-			if (cnt < BLCKSZ)
-				break;
+			if (cnt < nblocks * (off_t) BLCKSZ)
+			{
+				cnt -= cnt % BLCKSZ;
+				if (cnt == 0)
+					break;
+				ibindex = num_incremental_blocks;
+			}
 		}
 
 		/*
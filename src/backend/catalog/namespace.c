@@ -231,6 +231,7 @@ static void InitTempTableNamespace(void);
 static void RemoveTempRelations(Oid tempNamespaceId);
 static void RemoveTempRelationsCallback(int code, Datum arg);
 static void InvalidationCallback(Datum arg, int cacheid, uint32 hashvalue);
+static void RelnameCacheCallback(Datum arg, int cacheid, uint32 hashvalue);
 static bool MatchNamedCall(HeapTuple proctup, int nargs, List *argnames,
 						   bool include_out_arguments, int pronargs,
 						   int **argnumbers);
@@ -414,6 +415,96 @@ spcache_insert(const char *searchPath, Oid roleid)
 	}
 }
 
+/*
+ * Cache of unqualified relation name resolutions for the active search path.
+ *
+ * RelnameGetRelid probes the catcache once per path element, which adds up
+ * for long search paths; this cache collapses a repeated lookup of the same
+ * name to a single hash probe.  Entries (including negative ones, stored as
+ * InvalidOid) are only valid for the activePathGeneration they were made
+ * under, and the whole cache is discarded whenever a pg_class invalidation
+ * arrives, since we cannot tell which name a message is for.
+ */
+typedef struct RelnameCacheEntry
+{
+	const char *relname;		/* hash key; in RelnameCacheContext */
+	Oid			relid;			/* resolved OID, or InvalidOid if no match */
+
+	/* needed for simplehash */
+	char		status;
+} RelnameCacheEntry;
+
+static inline uint32
+relnamecache_hash(const char *relname)
+{
+	fasthash_state hs;
+	int			name_len;
+
+	fasthash_init(&hs, 0);
+	name_len = fasthash_accum_cstring(&hs, relname);
+
+	return fasthash_final32(&hs, name_len);
+}
+
+#define SH_PREFIX		relnamehash
+#define SH_ELEMENT_TYPE	RelnameCacheEntry
+#define SH_KEY_TYPE		const char *
+#define SH_KEY			relname
+#define SH_HASH_KEY(tb, key)   	relnamecache_hash(key)
+#define SH_EQUAL(tb, a, b)		(strcmp(a, b) == 0)
+#define SH_SCOPE		static inline
+#define SH_DECLARE
+#define SH_DEFINE
+#include "lib/simplehash.h"
+
+/*
+ * As with the search path cache, reset the table if it grows unreasonably
+ * large rather than letting it accumulate every name the session has ever
+ * looked up.
+ */
+#define RELNAMECACHE_RESET_THRESHOLD	256
+
+static relnamehash_hash *RelnameCache = NULL;
+static MemoryContext RelnameCacheContext = NULL;
+static uint64 relnameCacheGeneration = 0;	/* 0 matches no generation */
+static bool relnameCacheValid = false;
+
+/*
+ * Create or reset the relation name cache as necessary.
+ */
+static void
+relnamecache_init(void)
+{
+	if (RelnameCache && relnameCacheValid &&
+		relnameCacheGeneration == activePathGeneration &&
+		RelnameCache->members < RELNAMECACHE_RESET_THRESHOLD)
+		return;
+
+	relnameCacheValid = false;
+
+	/*
+	 * Make sure we don't leave dangling pointers if a failure happens during
+	 * initialization.
+	 */
+	RelnameCache = NULL;
+
+	if (RelnameCacheContext == NULL)
+	{
+		RelnameCacheContext = AllocSetContextCreate(TopMemoryContext,
+													"relation name cache",
+													ALLOCSET_DEFAULT_SIZES);
+	}
+	else
+	{
+		MemoryContextReset(RelnameCacheContext);
+	}
+
+	/* arbitrary initial starting size of 16 elements */
+	RelnameCache = relnamehash_create(RelnameCacheContext, 16, NULL);
+	relnameCacheGeneration = activePathGeneration;
+	relnameCacheValid = true;
+}
+
 /*
  * RangeVarGetRelidExtended
  *		Given a RangeVar describing an existing relation,
@@ -884,22 +975,39 @@ RangeVarAdjustRelationPersistence(RangeVar *newRelation, Oid nspid)
 Oid
 RelnameGetRelid(const char *relname)
 {
-	Oid			relid;
+	Oid			relid = InvalidOid;
 	ListCell   *l;
+	RelnameCacheEntry *entry;
+	bool		found;
 
 	recomputeNamespacePath();
 
+	relnamecache_init();
+	entry = relnamehash_lookup(RelnameCache, relname);
+	if (entry)
+		return entry->relid;
+
 	foreach(l, activeSearchPath)
 	{
 		Oid			namespaceId = lfirst_oid(l);
 
 		relid = get_relname_relid(relname, namespaceId);
 		if (OidIsValid(relid))
-			return relid;
+			break;
 	}
 
-	/* Not found in path */
-	return InvalidOid;
+	/*
+	 * Remember the result, whether we found a relation or not.  Copy the key
+	 * first so that an OOM cannot leave an entry without a valid key.
+	 */
+	entry = relnamehash_insert(RelnameCache,
+							   MemoryContextStrdup(RelnameCacheContext,
+												   relname),
+							   &found);
+	Assert(!found);
+	entry->relid = relid;
+
+	return relid;
 }
 
 
@@ -4782,6 +4890,11 @@ InitializeSearchPath(void)
 									  InvalidationCallback,
 									  (Datum) 0);
 
+		/* any pg_class change may invalidate cached name resolutions */
+		CacheRegisterSyscacheCallback(RELNAMENSP,
+									  RelnameCacheCallback,
+									  (Datum) 0);
+
 		/* Force search path to be recomputed on next use */
 		baseSearchPathValid = false;
 		searchPathCacheValid = false;
@@ -4804,6 +4917,20 @@ InvalidationCallback(Datum arg, int cacheid, uint32 hashvalue)
 	searchPathCacheValid = false;
 }
 
+/*
+ * RelnameCacheCallback
+ *		Syscache inval callback function for the relation name cache
+ */
+static void
+RelnameCacheCallback(Datum arg, int cacheid, uint32 hashvalue)
+{
+	/*
+	 * A pg_class tuple changed; any cached resolution, positive or negative,
+	 * may be stale.  Force the relation name cache to be rebuilt on next use.
+	 */
+	relnameCacheValid = false;
+}
+
 /*
  * Fetch the active search path. The return value is a palloc'ed list
  * of OIDs; the caller is responsible for freeing this storage as
@@ -505,57 +505,77 @@ RelationCopyStorage(SMgrRelation src, SMgrRelation dst,
 
 	nblocks = smgrnblocks(src, forkNum);
 
-	for (blkno = 0; blkno < nblocks; blkno++)
+	/*
+	 * Copy in batches of up to io_combine_limit blocks, so that the source
+	 * side is read with vectored I/O rather than one syscall per block.  The
+	 * destination side batches its writes internally (see bulk_write.c).
+	 */
+	for (blkno = 0; blkno < nblocks;)
 	{
-		BulkWriteBuffer buf;
-		int			piv_flags;
-		bool		checksum_failure;
-		bool		verified;
+		BulkWriteBuffer bufs[MAX_IO_COMBINE_LIMIT];
+		void	   *pages[MAX_IO_COMBINE_LIMIT];
+		int			nbatch;
 
 		/* If we got a cancel signal during the copy of the data, quit */
 		CHECK_FOR_INTERRUPTS();
 
-		buf = smgr_bulk_get_buf(bulkstate);
-		smgrread(src, forkNum, blkno, (Page) buf);
+		nbatch = Min(io_combine_limit, nblocks - blkno);
 
-		piv_flags = PIV_LOG_WARNING;
-		if (ignore_checksum_failure)
-			piv_flags |= PIV_IGNORE_CHECKSUM_FAILURE;
-		verified = PageIsVerified((Page) buf, blkno, piv_flags,
-								  &checksum_failure);
-		if (checksum_failure)
+		for (int i = 0; i < nbatch; i++)
 		{
-			RelFileLocatorBackend rloc = src->smgr_rlocator;
-
-			pgstat_prepare_report_checksum_failure(rloc.locator.dbOid);
-			pgstat_report_checksum_failures_in_db(rloc.locator.dbOid, 1);
+			bufs[i] = smgr_bulk_get_buf(bulkstate);
+			pages[i] = bufs[i];
 		}
+		smgrreadv(src, forkNum, blkno, pages, nbatch);
 
-		if (!verified)
+		for (int i = 0; i < nbatch; i++)
 		{
+			BulkWriteBuffer buf = bufs[i];
+			int			piv_flags;
+			bool		checksum_failure;
+			bool		verified;
+
+			piv_flags = PIV_LOG_WARNING;
+			if (ignore_checksum_failure)
+				piv_flags |= PIV_IGNORE_CHECKSUM_FAILURE;
+			verified = PageIsVerified((Page) buf, blkno, piv_flags,
+									  &checksum_failure);
+			if (checksum_failure)
+			{
+				RelFileLocatorBackend rloc = src->smgr_rlocator;
+
+				pgstat_prepare_report_checksum_failure(rloc.locator.dbOid);
+				pgstat_report_checksum_failures_in_db(rloc.locator.dbOid, 1);
+			}
+
+			if (!verified)
+			{
+				/*
+				 * For paranoia's sake, capture the file path before invoking
+				 * the ereport machinery.  This guards against the possibility
+				 * of a relcache flush caused by, e.g., an errcontext
+				 * callback.  (errcontext callbacks shouldn't be risking any
+				 * such thing, but people have been known to forget that
+				 * rule.)
+				 */
+				RelPathStr	relpath = relpathbackend(src->smgr_rlocator.locator,
+													 src->smgr_rlocator.backend,
+													 forkNum);
+
+				ereport(ERROR,
+						(errcode(ERRCODE_DATA_CORRUPTED),
+						 errmsg("invalid page in block %u of relation %s",
+								blkno, relpath.str)));
+			}
+
 			/*
-			 * For paranoia's sake, capture the file path before invoking the
-			 * ereport machinery.  This guards against the possibility of a
-			 * relcache flush caused by, e.g., an errcontext callback.
-			 * (errcontext callbacks shouldn't be risking any such thing, but
-			 * people have been known to forget that rule.)
+			 * Queue the page for WAL-logging and writing out.  Unfortunately
+			 * we don't know what kind of a page this is, so we have to log
+			 * the full page including any unused space.
 			 */
-			RelPathStr	relpath = relpathbackend(src->smgr_rlocator.locator,
-												 src->smgr_rlocator.backend,
-												 forkNum);
-
-			ereport(ERROR,
-					(errcode(ERRCODE_DATA_CORRUPTED),
-					 errmsg("invalid page in block %u of relation %s",
-							blkno, relpath.str)));
+			smgr_bulk_write(bulkstate, blkno, buf, false);
+			blkno++;
 		}
-
-		/*
-		 * Queue the page for WAL-logging and writing out.  Unfortunately we
-		 * don't know what kind of a page this is, so we have to log the full
-		 * page including any unused space.
-		 */
-		smgr_bulk_write(bulkstate, blkno, buf, false);
 	}
 	smgr_bulk_finish(bulkstate);
 }
@@ -72,6 +72,7 @@
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "port/pg_bswap.h"
+#include "port/simd.h"
 #include "utils/builtins.h"
 #include "utils/rel.h"
 
@@ -1328,6 +1329,42 @@ CopyReadLineText(CopyFromState cstate, bool is_csv)
 			need_data = false;
 		}
 
+		/*
+		 * Skip over bytes that cannot affect our parsing state, a vector at
+		 * a time.  We must stop at newline, carriage return and backslash
+		 * (text mode), or at newline, carriage return, quote and escape
+		 * (CSV mode; CR/LF matter even inside quotes, for line counting and
+		 * quoted-newline handling, so they stop the scan regardless of
+		 * in_quote).  Everything else is simply part of the current line,
+		 * and REFILL_LINEBUF will transfer it to line_buf wholesale.
+		 */
+		while (input_buf_ptr + (int) sizeof(Vector8) <= copy_buf_len)
+		{
+			Vector8		chunk;
+
+			vector8_load(&chunk, (const uint8 *) &copy_input_buf[input_buf_ptr]);
+			if (vector8_has(chunk, '\n') ||
+				vector8_has(chunk, '\r'))
+				break;
+			if (is_csv)
+			{
+				if (vector8_has(chunk, quotec) ||
+					(escapec != '\0' && vector8_has(chunk, escapec)))
+					break;
+			}
+			else if (vector8_has(chunk, '\\'))
+				break;
+			input_buf_ptr += sizeof(Vector8);
+
+			/*
+			 * The skipped bytes contained no escape character, so the scalar
+			 * loop below would have cleared this flag while walking them.
+			 */
+			last_was_esc = false;
+		}
+		if (input_buf_ptr >= copy_buf_len)
+			continue;			/* go refill the input buffer */
+
 		/* OK to fetch a character */
 		prev_raw_ptr = input_buf_ptr;
 		c = copy_input_buf[input_buf_ptr++];
@@ -1900,6 +1937,25 @@ CopyReadAttributesCSV(CopyFromState cstate)
 			/* Not in quote */
 			for (;;)
 			{
+				/*
+				 * Bulk-copy runs containing neither the delimiter nor the
+				 * quote character.  The output is never longer than the
+				 * input, and attribute_buf was pre-enlarged to the full line
+				 * length above, so the vector-sized stores cannot overrun.
+				 */
+				while (cur_ptr + sizeof(Vector8) <= line_end_ptr)
+				{
+					Vector8		chunk;
+
+					vector8_load(&chunk, (const uint8 *) cur_ptr);
+					if (vector8_has(chunk, delimc) ||
+						vector8_has(chunk, quotec))
+						break;
+					memcpy(output_ptr, cur_ptr, sizeof(Vector8));
+					cur_ptr += sizeof(Vector8);
+					output_ptr += sizeof(Vector8);
+				}
+
 				end_ptr = cur_ptr;
 				if (cur_ptr >= line_end_ptr)
 					goto endfield;
@@ -1923,6 +1979,20 @@ CopyReadAttributesCSV(CopyFromState cstate)
 			/* In quote */
 			for (;;)
 			{
+				/* likewise, bulk-copy runs without quote or escape chars */
+				while (cur_ptr + sizeof(Vector8) <= line_end_ptr)
+				{
+					Vector8		chunk;
+
+					vector8_load(&chunk, (const uint8 *) cur_ptr);
+					if (vector8_has(chunk, quotec) ||
+						vector8_has(chunk, escapec))
+						break;
+					memcpy(output_ptr, cur_ptr, sizeof(Vector8));
+					cur_ptr += sizeof(Vector8);
+					output_ptr += sizeof(Vector8);
+				}
+
 				end_ptr = cur_ptr;
 				if (cur_ptr >= line_end_ptr)
 					ereport(ERROR,
@@ -13,6 +13,7 @@
  */
 #include "postgres.h"
 
+#include "access/relscan.h"
 #include "access/xact.h"
 #include "catalog/pg_type.h"
 #include "commands/createas.h"
@@ -3914,15 +3915,28 @@ show_indexsearches_info(PlanState *planstate, ExplainState *es)
 static void
 show_tidbitmap_info(BitmapHeapScanState *planstate, ExplainState *es)
 {
+	TableScanDesc scanDesc = planstate->ss.ss_currentScanDesc;
+
 	if (!es->analyze)
 		return;
 
+	/*
+	 * EXPLAIN output is produced before ExecutorEnd runs, so the look-ahead
+	 * high-water mark maintained by the table AM has not yet been folded into
+	 * the node statistics; pick it up from the live scan descriptor.
+	 */
+	if (scanDesc)
+		planstate->stats.max_lookahead = Max(planstate->stats.max_lookahead,
+											 scanDesc->st.bitmap.rs_maxlookahead);
+
 	if (es->format != EXPLAIN_FORMAT_TEXT)
 	{
 		ExplainPropertyUInteger("Exact Heap Blocks", NULL,
 								planstate->stats.exact_pages, es);
 		ExplainPropertyUInteger("Lossy Heap Blocks", NULL,
 								planstate->stats.lossy_pages, es);
+		ExplainPropertyInteger("Heap Block Lookahead", NULL,
+							   planstate->stats.max_lookahead, es);
 	}
 	else
 	{
@@ -3934,6 +3948,8 @@ show_tidbitmap_info(BitmapHeapScanState *planstate, ExplainState *es)
 				appendStringInfo(es->str, " exact=" UINT64_FORMAT, planstate->stats.exact_pages);
 			if (planstate->stats.lossy_pages > 0)
 				appendStringInfo(es->str, " lossy=" UINT64_FORMAT, planstate->stats.lossy_pages);
+			if (planstate->stats.max_lookahead > 1)
+				appendStringInfo(es->str, " lookahead=%d", planstate->stats.max_lookahead);
 			appendStringInfoChar(es->str, '\n');
 		}
 	}
@@ -3959,6 +3975,8 @@ show_tidbitmap_info(BitmapHeapScanState *planstate, ExplainState *es)
 					appendStringInfo(es->str, " exact=" UINT64_FORMAT, si->exact_pages);
 				if (si->lossy_pages > 0)
 					appendStringInfo(es->str, " lossy=" UINT64_FORMAT, si->lossy_pages);
+				if (si->max_lookahead > 1)
+					appendStringInfo(es->str, " lookahead=%d", si->max_lookahead);
 				appendStringInfoChar(es->str, '\n');
 			}
 			else
@@ -3967,6 +3985,8 @@ show_tidbitmap_info(BitmapHeapScanState *planstate, ExplainState *es)
 										si->exact_pages, es);
 				ExplainPropertyUInteger("Lossy Heap Blocks", NULL,
 										si->lossy_pages, es);
+				ExplainPropertyInteger("Heap Block Lookahead", NULL,
+									   si->max_lookahead, es);
 			}
 
 			if (es->workers_state)
@@ -2299,6 +2299,7 @@ ExecInterpExprStillValid(ExprState *state, ExprContext *econtext, bool *isNull)
 	return state->evalfunc(state, econtext, isNull);
 }
 
+
 /*
  * Check that an expression is still valid in the face of potential schema
  * changes since the plan has been created.
@@ -66,7 +66,17 @@
 #define PARALLEL_KEY_JIT_INSTRUMENTATION UINT64CONST(0xE000000000000009)
 #define PARALLEL_KEY_WAL_USAGE			UINT64CONST(0xE00000000000000A)
 
-#define PARALLEL_TUPLE_QUEUE_SIZE		65536
+/*
+ * Size of the queue used to move tuples from each parallel worker to the
+ * leader, set with the parallel_tuple_queue_size GUC (stored in KB).  The
+ * GUC is read only once per parallel context, in ExecInitParallelPlan, and
+ * the resulting size is stored in FixedParallelExecutorState; both queue
+ * re-creation on rescan and the workers' attach must use that stored value
+ * rather than the live GUC, since the setting could change mid-query.
+ */
+int			parallel_tuple_queue_size = 64;
+
+#define PARALLEL_TUPLE_QUEUE_SIZE	((Size) parallel_tuple_queue_size * 1024)
 
 /*
  * Fixed-size random stuff that we need to pass to parallel workers.
@@ -77,6 +87,7 @@ typedef struct FixedParallelExecutorState
 	dsa_pointer param_exec;
 	int			eflags;
 	int			jit_flags;
+	Size		tuple_queue_size;	/* size of each worker's tuple queue */
 } FixedParallelExecutorState;
 
 /*
@@ -547,6 +558,7 @@ ExecParallelInitializeDSM(PlanState *planstate,
 static shm_mq_handle **
 ExecParallelSetupTupleQueues(ParallelContext *pcxt, bool reinitialize)
 {
+	FixedParallelExecutorState *fpes;
 	shm_mq_handle **responseq;
 	char	   *tqueuespace;
 	int			i;
@@ -555,6 +567,13 @@ ExecParallelSetupTupleQueues(ParallelContext *pcxt, bool reinitialize)
 	if (pcxt->nworkers == 0)
 		return NULL;
 
+	/*
+	 * Use the queue size captured at ExecInitParallelPlan time; the DSM
+	 * space was sized with that value, so we must not consult the GUC
+	 * again here.
+	 */
+	fpes = shm_toc_lookup(pcxt->toc, PARALLEL_KEY_EXECUTOR_FIXED, false);
+
 	/* Allocate memory for shared memory queue handles. */
 	responseq = (shm_mq_handle **)
 		palloc(pcxt->nworkers * sizeof(shm_mq_handle *));
@@ -566,7 +585,7 @@ ExecParallelSetupTupleQueues(ParallelContext *pcxt, bool reinitialize)
 	if (!reinitialize)
 		tqueuespace =
 			shm_toc_allocate(pcxt->toc,
-							 mul_size(PARALLEL_TUPLE_QUEUE_SIZE,
+							 mul_size(fpes->tuple_queue_size,
 									  pcxt->nworkers));
 	else
 		tqueuespace = shm_toc_lookup(pcxt->toc, PARALLEL_KEY_TUPLE_QUEUE, false);
@@ -577,8 +596,8 @@ ExecParallelSetupTupleQueues(ParallelContext *pcxt, bool reinitialize)
 		shm_mq	   *mq;
 
 		mq = shm_mq_create(tqueuespace +
-						   ((Size) i) * PARALLEL_TUPLE_QUEUE_SIZE,
-						   (Size) PARALLEL_TUPLE_QUEUE_SIZE);
+						   ((Size) i) * fpes->tuple_queue_size,
+						   fpes->tuple_queue_size);
 
 		shm_mq_set_receiver(mq, MyProc);
 		responseq[i] = shm_mq_attach(mq, pcxt->seg, NULL);
@@ -619,6 +638,7 @@ ExecInitParallelPlan(PlanState *planstate, EState *estate,
 	int			jit_instrumentation_len = 0;
 	int			instrument_offset = 0;
 	Size		dsa_minsize = dsa_minimum_size();
+	Size		tqueue_size = PARALLEL_TUPLE_QUEUE_SIZE;
 	char	   *query_string;
 	int			query_len;
 
@@ -693,7 +713,7 @@ ExecInitParallelPlan(PlanState *planstate, EState *estate,
 
 	/* Estimate space for tuple queues. */
 	shm_toc_estimate_chunk(&pcxt->estimator,
-						   mul_size(PARALLEL_TUPLE_QUEUE_SIZE, pcxt->nworkers));
+						   mul_size(tqueue_size, pcxt->nworkers));
 	shm_toc_estimate_keys(&pcxt->estimator, 1);
 
 	/*
@@ -757,6 +777,7 @@ ExecInitParallelPlan(PlanState *planstate, EState *estate,
 	fpes->param_exec = InvalidDsaPointer;
 	fpes->eflags = estate->es_top_eflags;
 	fpes->jit_flags = estate->es_jit_flags;
+	fpes->tuple_queue_size = tqueue_size;
 	shm_toc_insert(pcxt->toc, PARALLEL_KEY_EXECUTOR_FIXED, fpes);
 
 	/* Store query string */
@@ -1013,9 +1034,11 @@ ExecParallelReInitializeDSM(PlanState *planstate,
 				ExecHashJoinReInitializeDSM((HashJoinState *) planstate,
 											pcxt);
 			break;
+		case T_SortState:
+			ExecSortReInitializeDSM((SortState *) planstate, pcxt);
+			break;
 		case T_BitmapIndexScanState:
 		case T_HashState:
-		case T_SortState:
 		case T_IncrementalSortState:
 		case T_MemoizeState:
 			/* these nodes have DSM state, but no reinitialization is required */
@@ -1245,11 +1268,19 @@ ExecParallelCleanup(ParallelExecutorInfo *pei)
 static DestReceiver *
 ExecParallelGetReceiver(dsm_segment *seg, shm_toc *toc)
 {
+	FixedParallelExecutorState *fpes;
 	char	   *mqspace;
 	shm_mq	   *mq;
 
+	/*
+	 * The queues were laid out with the size the leader captured at
+	 * ExecInitParallelPlan time, which need not match this worker's
+	 * current GUC setting.
+	 */
+	fpes = shm_toc_lookup(toc, PARALLEL_KEY_EXECUTOR_FIXED, false);
+
 	mqspace = shm_toc_lookup(toc, PARALLEL_KEY_TUPLE_QUEUE, false);
-	mqspace += ParallelWorkerNumber * PARALLEL_TUPLE_QUEUE_SIZE;
+	mqspace += ParallelWorkerNumber * fpes->tuple_queue_size;
 	mq = (shm_mq *) mqspace;
 	shm_mq_set_sender(mq, MyProc);
 	return CreateTupleQueueDestReceiver(shm_mq_attach(mq, seg, NULL));
@@ -18,9 +18,12 @@
  */
 #include "postgres.h"
 
+#include "catalog/pg_type.h"
 #include "executor/executor.h"
 #include "executor/execScan.h"
 #include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
+#include "utils/fmgroids.h"
 
 /* ----------------------------------------------------------------
  *		ExecScan
@@ -154,3 +157,98 @@ ExecScanReScan(ScanState *node)
 		}
 	}
 }
+
+/*
+ * ExecScanInitSimpleQual
+ *		Recognize quals eligible for the simple-comparison fast path.
+ *
+ * If the node's qual is a single "Var op Const" (or "Const op Var") btree
+ * comparison on a non-system int4 column of the scanned relation, set up
+ * node->ss_simplequal so that ExecScanExtended can check tuples without
+ * going through the general expression machinery.  Otherwise leave it NULL
+ * and the qual is evaluated with ExecQual as usual.
+ *
+ * We insist on the built-in int4 comparison operators: they are strict,
+ * leakproof, and have no collation or side effects, so evaluating them
+ * directly cannot change semantics.
+ */
+void
+ExecScanInitSimpleQual(ScanState *node)
+{
+	List	   *qual = node->ps.plan->qual;
+	Index		scanrelid = ((Scan *) node->ps.plan)->scanrelid;
+	OpExpr	   *opexpr;
+	Node	   *leftop;
+	Node	   *rightop;
+	Var		   *var;
+	Const	   *con;
+	bool		commuted;
+	StrategyNumber strategy;
+	ExecScanSimpleQual *sq;
+
+	node->ss_simplequal = NULL;
+
+	if (list_length(qual) != 1 || scanrelid == 0)
+		return;
+	if (!IsA(linitial(qual), OpExpr))
+		return;
+	opexpr = (OpExpr *) linitial(qual);
+	if (list_length(opexpr->args) != 2)
+		return;
+
+	leftop = (Node *) linitial(opexpr->args);
+	rightop = (Node *) lsecond(opexpr->args);
+	if (IsA(leftop, Var) && IsA(rightop, Const))
+	{
+		var = (Var *) leftop;
+		con = (Const *) rightop;
+		commuted = false;
+	}
+	else if (IsA(leftop, Const) && IsA(rightop, Var))
+	{
+		var = (Var *) rightop;
+		con = (Const *) leftop;
+		commuted = true;
+	}
+	else
+		return;
+
+	if (var->varno != scanrelid || var->varattno <= 0 ||
+		var->vartype != INT4OID || var->varlevelsup != 0)
+		return;
+	if (con->constisnull || con->consttype != INT4OID)
+		return;
+
+	set_opfuncid(opexpr);
+	switch (opexpr->opfuncid)
+	{
+		case F_INT4LT:
+			strategy = BTLessStrategyNumber;
+			break;
+		case F_INT4LE:
+			strategy = BTLessEqualStrategyNumber;
+			break;
+		case F_INT4EQ:
+			strategy = BTEqualStrategyNumber;
+			break;
+		case F_INT4GE:
+			strategy = BTGreaterEqualStrategyNumber;
+			break;
+		case F_INT4GT:
+			strategy = BTGreaterStrategyNumber;
+			break;
+		default:
+			return;
+	}
+
+	/* put the Var on the left if the qual had it on the right */
+	if (commuted)
+		strategy = BTMaxStrategyNumber + 1 - strategy;
+
+	sq = (ExecScanSimpleQual *) palloc(sizeof(ExecScanSimpleQual));
+	sq->attnum = var->varattno;
+	sq->cmpval = DatumGetInt32(con->constvalue);
+	sq->strategy = strategy;
+	node->ss_simplequal = sq;
+}
+
@@ -255,6 +255,7 @@
 #include "catalog/pg_proc.h"
 #include "catalog/pg_type.h"
 #include "common/hashfn.h"
+#include "common/pg_lzcompress.h"
 #include "executor/execExpr.h"
 #include "executor/executor.h"
 #include "executor/nodeAgg.h"
@@ -315,6 +316,19 @@
  */
 #define HASHAGG_HLL_BIT_WIDTH 5
 
+/*
+ * When hashagg_spill_compress is enabled, spilled tuples at least this large
+ * are pglz-compressed on the tape.  A compressed tuple is marked by setting
+ * the high bit of the on-tape length word, which is otherwise unused since
+ * tuple lengths are far below 2GB.  Short tuples are stored verbatim; pglz
+ * rarely wins on them and the attempt isn't free.
+ */
+#define HASHAGG_SPILL_COMPRESS_MIN	64
+#define HASHAGG_SPILL_COMPRESSED	0x80000000u
+
+/* GUC: compress hash aggregation spill data */
+bool		hashagg_spill_compress = false;
+
 /*
  * Assume the palloc overhead always uses sizeof(MemoryChunk) bytes.
  */
@@ -3078,6 +3092,40 @@ hashagg_spill_tuple(AggState *aggstate, HashAggSpill *spill,
 	LogicalTapeWrite(tape, &hash, sizeof(uint32));
 	total_written += sizeof(uint32);
 
+	/*
+	 * Try to compress the tuple body (everything after the length word) if
+	 * enabled and the tuple is big enough to plausibly benefit.  Compressed
+	 * tuples are written as a flagged compressed length, the original
+	 * length, and the compressed bytes; hashagg_batch_read undoes this.  If
+	 * pglz can't shrink the tuple it is stored verbatim.
+	 */
+	if (hashagg_spill_compress &&
+		tuple->t_len - sizeof(uint32) >= HASHAGG_SPILL_COMPRESS_MIN)
+	{
+		uint32		bodylen = tuple->t_len - sizeof(uint32);
+		char	   *cbuf = palloc(PGLZ_MAX_OUTPUT(bodylen));
+		int32		clen;
+
+		clen = pglz_compress((char *) tuple + sizeof(uint32), bodylen,
+							 cbuf, PGLZ_strategy_default);
+		if (clen >= 0)
+		{
+			uint32		chead = (uint32) clen | HASHAGG_SPILL_COMPRESSED;
+
+			LogicalTapeWrite(tape, &chead, sizeof(uint32));
+			LogicalTapeWrite(tape, &tuple->t_len, sizeof(uint32));
+			LogicalTapeWrite(tape, cbuf, clen);
+			total_written += 2 * sizeof(uint32) + clen;
+
+			pfree(cbuf);
+			if (shouldFree)
+				pfree(tuple);
+
+			return total_written;
+		}
+		pfree(cbuf);
+	}
+
 	LogicalTapeWrite(tape, tuple, tuple->t_len);
 	total_written += tuple->t_len;
 
@@ -3139,6 +3187,41 @@ hashagg_batch_read(HashAggBatch *batch, uint32 *hashp)
 				 errmsg_internal("unexpected EOF for tape %p: requested %zu bytes, read %zu bytes",
 								 tape, sizeof(uint32), nread)));
 
+	if (t_len & HASHAGG_SPILL_COMPRESSED)
+	{
+		/* compressed by hashagg_spill_tuple; see there for the format */
+		uint32		clen = t_len & ~HASHAGG_SPILL_COMPRESSED;
+		char	   *cbuf;
+
+		nread = LogicalTapeRead(tape, &t_len, sizeof(t_len));
+		if (nread != sizeof(uint32))
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg_internal("unexpected EOF for tape %p: requested %zu bytes, read %zu bytes",
+									 tape, sizeof(uint32), nread)));
+
+		cbuf = palloc(clen);
+		nread = LogicalTapeRead(tape, cbuf, clen);
+		if (nread != clen)
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg_internal("unexpected EOF for tape %p: requested %zu bytes, read %zu bytes",
+									 tape, (size_t) clen, nread)));
+
+		tuple = (MinimalTuple) palloc(t_len);
+		tuple->t_len = t_len;
+		if (pglz_decompress(cbuf, clen,
+							(char *) tuple + sizeof(uint32),
+							t_len - sizeof(uint32), true) !=
+			(int32) (t_len - sizeof(uint32)))
+			ereport(ERROR,
+					(errcode(ERRCODE_DATA_CORRUPTED),
+					 errmsg_internal("invalid compressed hash aggregation spill data")));
+		pfree(cbuf);
+
+		return tuple;
+	}
+
 	tuple = (MinimalTuple) palloc(t_len);
 	tuple->t_len = t_len;
 
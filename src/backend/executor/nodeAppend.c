@@ -63,7 +63,10 @@
 #include "executor/nodeAppend.h"
 #include "miscadmin.h"
 #include "pgstat.h"
+#include "storage/bufmgr.h"
 #include "storage/latch.h"
+#include "utils/rel.h"
+#include "utils/spccache.h"
 
 /* Shared state for parallel-aware Append. */
 struct ParallelAppendState
@@ -85,6 +88,7 @@ struct ParallelAppendState
 
 static TupleTableSlot *ExecAppend(PlanState *pstate);
 static bool choose_next_subplan_locally(AppendState *node);
+static void ExecAppendPrefetchNext(AppendState *node, int whichplan);
 static bool choose_next_subplan_for_leader(AppendState *node);
 static bool choose_next_subplan_for_worker(AppendState *node);
 static void mark_invalid_subplans_as_finished(AppendState *node);
@@ -620,9 +624,56 @@ choose_next_subplan_locally(AppendState *node)
 
 	node->as_whichplan = nextplan;
 
+	/*
+	 * Hint the storage layer about the partition we'll move to after this
+	 * one, so its first blocks are being read while the chosen subplan
+	 * executes.  This gives cold scans over many partitions some I/O
+	 * overlap even though the children run synchronously.
+	 */
+	if (ScanDirectionIsForward(node->ps.state->es_direction))
+		ExecAppendPrefetchNext(node, nextplan);
+
 	return true;
 }
 
+/*
+ * Issue prefetch requests for the leading blocks of the valid subplan
+ * following "whichplan", when that subplan is a plain sequential scan.
+ * Other subplan types are left alone; for them we cannot cheaply tell
+ * which blocks they will read first.
+ */
+static void
+ExecAppendPrefetchNext(AppendState *node, int whichplan)
+{
+#ifdef USE_PREFETCH
+	int			nextplan;
+	PlanState  *ps;
+	Relation	rel;
+	BlockNumber nblocks;
+	int			distance;
+
+	nextplan = bms_next_member(node->as_valid_subplans, whichplan);
+	if (nextplan < 0)
+		return;
+
+	ps = node->appendplans[nextplan];
+	if (!IsA(ps, SeqScanState))
+		return;
+
+	rel = ((SeqScanState *) ps)->ss.ss_currentRelation;
+	if (rel == NULL)
+		return;
+
+	distance = get_tablespace_io_concurrency(rel->rd_rel->reltablespace);
+	nblocks = RelationGetNumberOfBlocks(rel);
+	if (nblocks > (BlockNumber) distance)
+		nblocks = (BlockNumber) distance;
+
+	for (BlockNumber blkno = 0; blkno < nblocks; blkno++)
+		PrefetchBuffer(rel, MAIN_FORKNUM, blkno);
+#endif							/* USE_PREFETCH */
+}
+
 /* ----------------------------------------------------------------
  *		choose_next_subplan_for_leader
  *
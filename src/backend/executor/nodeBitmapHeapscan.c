@@ -110,9 +110,10 @@ BitmapTableScanSetup(BitmapHeapScanState *node)
 							   node->ss.ps.state->es_snapshot,
 							   0,
 							   NULL);
+		node->ss.ss_currentScanDesc->st.bitmap.rs_maxlookahead = 0;
 	}
 
-	node->ss.ss_currentScanDesc->st.rs_tbmiterator = tbmiterator;
+	node->ss.ss_currentScanDesc->st.bitmap.rs_tbmiterator = tbmiterator;
 	node->initialized = true;
 }
 
@@ -235,8 +236,8 @@ ExecReScanBitmapHeapScan(BitmapHeapScanState *node)
 		 * End iteration on iterators saved in scan descriptor if they have
 		 * not already been cleaned up.
 		 */
-		if (!tbm_exhausted(&scan->st.rs_tbmiterator))
-			tbm_end_iterate(&scan->st.rs_tbmiterator);
+		if (!tbm_exhausted(&scan->st.bitmap.rs_tbmiterator))
+			tbm_end_iterate(&scan->st.bitmap.rs_tbmiterator);
 
 		/* rescan to release any page pin */
 		table_rescan(node->ss.ss_currentScanDesc, NULL);
@@ -268,6 +269,15 @@ ExecEndBitmapHeapScan(BitmapHeapScanState *node)
 {
 	TableScanDesc scanDesc;
 
+	/*
+	 * Fold the look-ahead high-water mark maintained by the table AM into
+	 * this node's statistics before they are reported anywhere.
+	 */
+	scanDesc = node->ss.ss_currentScanDesc;
+	if (scanDesc)
+		node->stats.max_lookahead = Max(node->stats.max_lookahead,
+										scanDesc->st.bitmap.rs_maxlookahead);
+
 	/*
 	 * When ending a parallel worker, copy the statistics gathered by the
 	 * worker back into shared memory so that it can be picked up by the main
@@ -289,13 +299,9 @@ ExecEndBitmapHeapScan(BitmapHeapScanState *node)
 		 */
 		si->exact_pages += node->stats.exact_pages;
 		si->lossy_pages += node->stats.lossy_pages;
+		si->max_lookahead = Max(si->max_lookahead, node->stats.max_lookahead);
 	}
 
-	/*
-	 * extract information from the node
-	 */
-	scanDesc = node->ss.ss_currentScanDesc;
-
 	/*
 	 * close down subplans
 	 */
@@ -307,8 +313,8 @@ ExecEndBitmapHeapScan(BitmapHeapScanState *node)
 		 * End iteration on iterators saved in scan descriptor if they have
 		 * not already been cleaned up.
 		 */
-		if (!tbm_exhausted(&scanDesc->st.rs_tbmiterator))
-			tbm_end_iterate(&scanDesc->st.rs_tbmiterator);
+		if (!tbm_exhausted(&scanDesc->st.bitmap.rs_tbmiterator))
+			tbm_end_iterate(&scanDesc->st.bitmap.rs_tbmiterator);
 
 		/*
 		 * close table scan
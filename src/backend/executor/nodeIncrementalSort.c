@@ -478,6 +478,18 @@ switchToPresortedPrefixMode(PlanState *pstate)
  */
 #define DEFAULT_MAX_FULL_SORT_GROUP_SIZE (2 * DEFAULT_MIN_GROUP_SIZE)
 
+/*
+ * When the input consists of a huge number of tiny prefix key groups, even
+ * DEFAULT_MIN_GROUP_SIZE batches leave us paying the tuplesort reset and
+ * setup cost once per few dozen tuples.  Whenever a full sort batch ends
+ * having barely exceeded the minimum size, we double the minimum for
+ * subsequent batches so that one sort amortizes over many groups, up to this
+ * cap (chosen to keep batches small enough to preserve incremental sort's
+ * early-output and bounded-memory behavior).  The minimum snaps back to the
+ * default as soon as a large group forces prefix-sort mode.
+ */
+#define MAX_FULL_SORT_BATCH_SIZE 1024
+
 /* ----------------------------------------------------------------
  *		ExecIncrementalSort
  *
@@ -643,10 +655,10 @@ ExecIncrementalSort(PlanState *pstate)
 			if (currentBound < DEFAULT_MIN_GROUP_SIZE)
 				tuplesort_set_bound(fullsort_state, currentBound);
 
-			minGroupSize = Min(DEFAULT_MIN_GROUP_SIZE, currentBound);
+			minGroupSize = Min(node->min_group_size, currentBound);
 		}
 		else
-			minGroupSize = DEFAULT_MIN_GROUP_SIZE;
+			minGroupSize = node->min_group_size;
 
 		/*
 		 * Because we have to read the next tuple to find out that we've
@@ -767,6 +779,17 @@ ExecIncrementalSort(PlanState *pstate)
 						node->bound_Done = Min(node->bound, node->bound_Done + nTuples);
 					}
 
+					/*
+					 * If the batch ended almost as soon as it reached the
+					 * minimum size, the prefix key groups must be tiny
+					 * relative to the batch, so grow subsequent batches to
+					 * amortize the per-batch sort overhead over more groups.
+					 */
+					if (nTuples <= minGroupSize + minGroupSize / 4 &&
+						node->min_group_size < MAX_FULL_SORT_BATCH_SIZE)
+						node->min_group_size = Min(node->min_group_size * 2,
+												   (int64) MAX_FULL_SORT_BATCH_SIZE);
+
 					/*
 					 * Once we find changed prefix keys we can complete the
 					 * sort and transition modes to reading out the sorted
@@ -787,14 +810,21 @@ ExecIncrementalSort(PlanState *pstate)
 			/*
 			 * Unless we've already transitioned modes to reading from the
 			 * full sort state, then we assume that having read at least
-			 * DEFAULT_MAX_FULL_SORT_GROUP_SIZE tuples means it's likely we're
-			 * processing a large group of tuples all having equal prefix keys
-			 * (but haven't yet found the final tuple in that prefix key
+			 * twice the minimum batch size means it's likely we're
+			 * processing a large group of tuples all having equal prefix
+			 * keys (but haven't yet found the final tuple in that prefix key
 			 * group), so we need to transition into presorted prefix mode.
 			 */
-			if (nTuples > DEFAULT_MAX_FULL_SORT_GROUP_SIZE &&
+			if (nTuples > 2 * minGroupSize &&
 				node->execution_status != INCSORT_READFULLSORT)
 			{
+				/*
+				 * Since we've hit a large group, small-group batching is no
+				 * longer what we should optimize for; snap the batch size
+				 * back to its default.
+				 */
+				node->min_group_size = DEFAULT_MIN_GROUP_SIZE;
+
 				/*
 				 * The group pivot we have stored has already been put into
 				 * the tuplesort; we don't want to carry it over. Since we
@@ -1000,6 +1030,7 @@ ExecInitIncrementalSort(IncrementalSort *node, EState *estate, int eflags)
 	incrsortstate->prefixsort_state = NULL;
 	incrsortstate->group_pivot = NULL;
 	incrsortstate->transfer_tuple = NULL;
+	incrsortstate->min_group_size = DEFAULT_MIN_GROUP_SIZE;
 	incrsortstate->n_fullsort_remaining = 0;
 	incrsortstate->presorted_keys = NULL;
 
@@ -1132,6 +1163,7 @@ ExecReScanIncrementalSort(IncrementalSortState *node)
 		ExecClearTuple(node->transfer_tuple);
 
 	node->outerNodeDone = false;
+	node->min_group_size = DEFAULT_MIN_GROUP_SIZE;
 	node->n_fullsort_remaining = 0;
 	node->bound_Done = 0;
 
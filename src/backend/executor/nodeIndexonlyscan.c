@@ -102,6 +102,7 @@ IndexOnlyNext(IndexOnlyScanState *node)
 		/* Set it up for index-only scan */
 		node->ioss_ScanDesc->xs_want_itup = true;
 		node->ioss_VMBuffer = InvalidBuffer;
+		node->ioss_HeapFetchBlock = InvalidBlockNumber;
 
 		/*
 		 * If no run-time keys to calculate or they are ready, go ahead and
@@ -120,6 +121,7 @@ IndexOnlyNext(IndexOnlyScanState *node)
 	 */
 	while ((tid = index_getnext_tid(scandesc, direction)) != NULL)
 	{
+		BlockNumber blkno = ItemPointerGetBlockNumber(tid);
 		bool		tuple_from_heap = false;
 
 		CHECK_FOR_INTERRUPTS();
@@ -157,11 +159,23 @@ IndexOnlyNext(IndexOnlyScanState *node)
 		 *
 		 * It's worth going through this complexity to avoid needing to lock
 		 * the VM buffer, which could cause significant contention.
+		 *
+		 * Because index scans tend to return runs of TIDs on the same heap
+		 * page, we remember the last block the map said was not all-visible
+		 * and go straight to the heap for further TIDs on it, instead of
+		 * asking the map again.  That's safe: if the bit has been set in the
+		 * meantime, we merely do a heap fetch we could have skipped.  Note
+		 * that the opposite answer must never be cached, because of the
+		 * insert race described above -- the bit has to be read after the
+		 * TID, every time.
 		 */
-		if (!VM_ALL_VISIBLE(scandesc->heapRelation,
-							ItemPointerGetBlockNumber(tid),
+		if (blkno == node->ioss_HeapFetchBlock ||
+			!VM_ALL_VISIBLE(scandesc->heapRelation,
+							blkno,
 							&node->ioss_VMBuffer))
 		{
+			node->ioss_HeapFetchBlock = blkno;
+
 			/*
 			 * Rats, we have to visit the heap to check visibility.
 			 */
@@ -245,7 +259,7 @@ IndexOnlyNext(IndexOnlyScanState *node)
 		 */
 		if (!tuple_from_heap)
 			PredicateLockPage(scandesc->heapRelation,
-							  ItemPointerGetBlockNumber(tid),
+							  blkno,
 							  estate->es_snapshot);
 
 		return slot;
@@ -382,6 +396,7 @@ ExecReScanIndexOnlyScan(IndexOnlyScanState *node)
 	node->ioss_RuntimeKeysReady = true;
 
 	/* reset index scan */
+	node->ioss_HeapFetchBlock = InvalidBlockNumber;
 	if (node->ioss_ScanDesc)
 		index_rescan(node->ioss_ScanDesc,
 					 node->ioss_ScanKeys, node->ioss_NumScanKeys,
@@ -542,6 +557,7 @@ ExecInitIndexOnlyScan(IndexOnlyScan *node, EState *estate, int eflags)
 	indexstate->ss.ps.plan = (Plan *) node;
 	indexstate->ss.ps.state = estate;
 	indexstate->ss.ps.ExecProcNode = ExecIndexOnlyScan;
+	indexstate->ioss_HeapFetchBlock = InvalidBlockNumber;
 
 	/*
 	 * Miscellaneous initialization
@@ -792,6 +808,7 @@ ExecIndexOnlyScanInitializeDSM(IndexOnlyScanState *node,
 								 piscan);
 	node->ioss_ScanDesc->xs_want_itup = true;
 	node->ioss_VMBuffer = InvalidBuffer;
+	node->ioss_HeapFetchBlock = InvalidBlockNumber;
 
 	/*
 	 * If no run-time keys to calculate or they are ready, go ahead and pass
@@ -390,6 +390,9 @@ remove_cache_entry(MemoizeState *mstate, MemoizeEntry *entry)
 	/* Remove the entry from the cache */
 	memoize_delete_item(mstate->hashtable, entry);
 
+	/* deletion may have shuffled entries, so stop trusting the last one */
+	mstate->last_entry = NULL;
+
 	pfree(key->params);
 	pfree(key);
 }
@@ -420,6 +423,7 @@ cache_purge_all(MemoizeState *mstate)
 	dlist_init(&mstate->lru_list);
 	mstate->last_tuple = NULL;
 	mstate->entry = NULL;
+	mstate->last_entry = NULL;
 
 	mstate->mem_used = 0;
 
@@ -534,6 +538,23 @@ cache_lookup(MemoizeState *mstate, bool *found)
 	/* prepare the probe slot with the current scan parameters */
 	prepare_probe_slot(mstate, NULL);
 
+	/*
+	 * Fast path for runs of lookups with identical parameter values, as
+	 * commonly happens when the outer side of the join is sorted or
+	 * clustered on the cache keys.  The previous entry's pointer can only
+	 * be trusted if nothing has been inserted or evicted since it was
+	 * looked up, since simplehash may shuffle entries around; we set
+	 * last_entry to NULL whenever that could have happened.
+	 */
+	if (mstate->last_entry != NULL &&
+		MemoizeHash_equal(mstate->hashtable, mstate->last_entry->key, NULL))
+	{
+		entry = mstate->last_entry;
+		dlist_move_tail(&mstate->lru_list, &entry->key->lru_node);
+		*found = true;
+		return entry;
+	}
+
 	/*
 	 * Add the new entry to the cache.  No need to pass a valid key since the
 	 * hash function uses mstate's probeslot, which we populated above.
@@ -548,9 +569,13 @@ cache_lookup(MemoizeState *mstate, bool *found)
 		 */
 		dlist_move_tail(&mstate->lru_list, &entry->key->lru_node);
 
+		mstate->last_entry = entry;
 		return entry;
 	}
 
+	/* insertion may have shuffled entries; only 'entry' itself is stable */
+	mstate->last_entry = entry;
+
 	oldcontext = MemoryContextSwitchTo(mstate->tableContext);
 
 	/* Allocate a new key */
@@ -609,6 +634,8 @@ cache_lookup(MemoizeState *mstate, bool *found)
 			entry = memoize_lookup(mstate->hashtable, NULL);
 			Assert(entry != NULL);
 		}
+
+		mstate->last_entry = entry;
 	}
 
 	return entry;
@@ -1046,6 +1073,7 @@ ExecInitMemoize(Memoize *node, EState *estate, int eflags)
 	dlist_init(&mstate->lru_list);
 	mstate->last_tuple = NULL;
 	mstate->entry = NULL;
+	mstate->last_entry = NULL;
 
 	/*
 	 * Mark if we can assume the cache entry is completed after we get the
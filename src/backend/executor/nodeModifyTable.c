@@ -132,6 +132,17 @@ typedef struct UpdateContext
 } UpdateContext;
 
 
+/*
+ * Number of tuples to accumulate before flushing a multi-insert batch into a
+ * plain table.  This matches MAX_BUFFERED_TUPLES in COPY FROM.
+ */
+#define MT_TABLE_INSERT_BATCH_SIZE	1000
+
+static void ExecBatchInsertAddTuple(ModifyTableState *mtstate,
+									ResultRelInfo *resultRelInfo,
+									TupleTableSlot *slot,
+									TupleTableSlot *planSlot,
+									EState *estate);
 static void ExecBatchInsert(ModifyTableState *mtstate,
 							ResultRelInfo *resultRelInfo,
 							TupleTableSlot **slots,
@@ -864,7 +875,6 @@ ExecInsert(ModifyTableContext *context,
 	ModifyTable *node = (ModifyTable *) mtstate->ps.plan;
 	OnConflictAction onconflict = node->onConflictAction;
 	PartitionTupleRouting *proute = mtstate->mt_partition_tuple_routing;
-	MemoryContext oldContext;
 
 	/*
 	 * If the input result relation is a partitioned table, find the leaf
@@ -941,88 +951,8 @@ ExecInsert(ModifyTableContext *context,
 		 */
 		if (resultRelInfo->ri_BatchSize > 1)
 		{
-			bool		flushed = false;
-
-			/*
-			 * When we've reached the desired batch size, perform the
-			 * insertion.
-			 */
-			if (resultRelInfo->ri_NumSlots == resultRelInfo->ri_BatchSize)
-			{
-				ExecBatchInsert(mtstate, resultRelInfo,
-								resultRelInfo->ri_Slots,
-								resultRelInfo->ri_PlanSlots,
-								resultRelInfo->ri_NumSlots,
-								estate, canSetTag);
-				flushed = true;
-			}
-
-			oldContext = MemoryContextSwitchTo(estate->es_query_cxt);
-
-			if (resultRelInfo->ri_Slots == NULL)
-			{
-				resultRelInfo->ri_Slots = palloc(sizeof(TupleTableSlot *) *
-												 resultRelInfo->ri_BatchSize);
-				resultRelInfo->ri_PlanSlots = palloc(sizeof(TupleTableSlot *) *
-													 resultRelInfo->ri_BatchSize);
-			}
-
-			/*
-			 * Initialize the batch slots. We don't know how many slots will
-			 * be needed, so we initialize them as the batch grows, and we
-			 * keep them across batches. To mitigate an inefficiency in how
-			 * resource owner handles objects with many references (as with
-			 * many slots all referencing the same tuple descriptor) we copy
-			 * the appropriate tuple descriptor for each slot.
-			 */
-			if (resultRelInfo->ri_NumSlots >= resultRelInfo->ri_NumSlotsInitialized)
-			{
-				TupleDesc	tdesc = CreateTupleDescCopy(slot->tts_tupleDescriptor);
-				TupleDesc	plan_tdesc =
-					CreateTupleDescCopy(planSlot->tts_tupleDescriptor);
-
-				resultRelInfo->ri_Slots[resultRelInfo->ri_NumSlots] =
-					MakeSingleTupleTableSlot(tdesc, slot->tts_ops);
-
-				resultRelInfo->ri_PlanSlots[resultRelInfo->ri_NumSlots] =
-					MakeSingleTupleTableSlot(plan_tdesc, planSlot->tts_ops);
-
-				/* remember how many batch slots we initialized */
-				resultRelInfo->ri_NumSlotsInitialized++;
-			}
-
-			ExecCopySlot(resultRelInfo->ri_Slots[resultRelInfo->ri_NumSlots],
-						 slot);
-
-			ExecCopySlot(resultRelInfo->ri_PlanSlots[resultRelInfo->ri_NumSlots],
-						 planSlot);
-
-			/*
-			 * If these are the first tuples stored in the buffers, add the
-			 * target rel and the mtstate to the
-			 * es_insert_pending_result_relations and
-			 * es_insert_pending_modifytables lists respectively, except in
-			 * the case where flushing was done above, in which case they
-			 * would already have been added to the lists, so no need to do
-			 * this.
-			 */
-			if (resultRelInfo->ri_NumSlots == 0 && !flushed)
-			{
-				Assert(!list_member_ptr(estate->es_insert_pending_result_relations,
-										resultRelInfo));
-				estate->es_insert_pending_result_relations =
-					lappend(estate->es_insert_pending_result_relations,
-							resultRelInfo);
-				estate->es_insert_pending_modifytables =
-					lappend(estate->es_insert_pending_modifytables, mtstate);
-			}
-			Assert(list_member_ptr(estate->es_insert_pending_result_relations,
-								   resultRelInfo));
-
-			resultRelInfo->ri_NumSlots++;
-
-			MemoryContextSwitchTo(oldContext);
-
+			ExecBatchInsertAddTuple(mtstate, resultRelInfo, slot, planSlot,
+									estate);
 			return NULL;
 		}
 
@@ -1228,6 +1158,22 @@ ExecInsert(ModifyTableContext *context,
 
 			/* Since there was no insertion conflict, we're done */
 		}
+		else if (resultRelInfo->ri_BatchSize > 1)
+		{
+			/*
+			 * Accumulate rows and insert them with table_multi_insert in
+			 * batches, amortizing per-tuple WAL and buffer-management
+			 * overheads much as COPY FROM does.  Index entries for a batch
+			 * are added when it is flushed, in ExecBatchInsert.
+			 * ExecInitModifyTable enables this only when nothing below this
+			 * point in the per-row path (triggers, RETURNING) could observe
+			 * the delayed insertion; constraints, generated columns and RLS
+			 * policies have already been handled above.
+			 */
+			ExecBatchInsertAddTuple(mtstate, resultRelInfo, slot, planSlot,
+									estate);
+			return NULL;
+		}
 		else
 		{
 			/* insert the tuple normally */
@@ -1355,12 +1301,109 @@ ExecInsert(ModifyTableContext *context,
 	return result;
 }
 
+/* ----------------------------------------------------------------
+ *		ExecBatchInsertAddTuple
+ *
+ *		Subroutine for ExecInsert: add a tuple to the pending batch for the
+ *		given result relation, flushing the batch first if it is full.
+ * ----------------------------------------------------------------
+ */
+static void
+ExecBatchInsertAddTuple(ModifyTableState *mtstate,
+						ResultRelInfo *resultRelInfo,
+						TupleTableSlot *slot,
+						TupleTableSlot *planSlot,
+						EState *estate)
+{
+	bool		flushed = false;
+	MemoryContext oldContext;
+
+	/*
+	 * When we've reached the desired batch size, perform the insertion.
+	 */
+	if (resultRelInfo->ri_NumSlots == resultRelInfo->ri_BatchSize)
+	{
+		ExecBatchInsert(mtstate, resultRelInfo,
+						resultRelInfo->ri_Slots,
+						resultRelInfo->ri_PlanSlots,
+						resultRelInfo->ri_NumSlots,
+						estate, mtstate->canSetTag);
+		flushed = true;
+	}
+
+	oldContext = MemoryContextSwitchTo(estate->es_query_cxt);
+
+	if (resultRelInfo->ri_Slots == NULL)
+	{
+		resultRelInfo->ri_Slots = palloc(sizeof(TupleTableSlot *) *
+										 resultRelInfo->ri_BatchSize);
+		resultRelInfo->ri_PlanSlots = palloc(sizeof(TupleTableSlot *) *
+											 resultRelInfo->ri_BatchSize);
+	}
+
+	/*
+	 * Initialize the batch slots. We don't know how many slots will be
+	 * needed, so we initialize them as the batch grows, and we keep them
+	 * across batches. To mitigate an inefficiency in how resource owner
+	 * handles objects with many references (as with many slots all
+	 * referencing the same tuple descriptor) we copy the appropriate tuple
+	 * descriptor for each slot.
+	 */
+	if (resultRelInfo->ri_NumSlots >= resultRelInfo->ri_NumSlotsInitialized)
+	{
+		TupleDesc	tdesc = CreateTupleDescCopy(slot->tts_tupleDescriptor);
+		TupleDesc	plan_tdesc =
+			CreateTupleDescCopy(planSlot->tts_tupleDescriptor);
+
+		resultRelInfo->ri_Slots[resultRelInfo->ri_NumSlots] =
+			MakeSingleTupleTableSlot(tdesc, slot->tts_ops);
+
+		resultRelInfo->ri_PlanSlots[resultRelInfo->ri_NumSlots] =
+			MakeSingleTupleTableSlot(plan_tdesc, planSlot->tts_ops);
+
+		/* remember how many batch slots we initialized */
+		resultRelInfo->ri_NumSlotsInitialized++;
+	}
+
+	ExecCopySlot(resultRelInfo->ri_Slots[resultRelInfo->ri_NumSlots],
+				 slot);
+
+	ExecCopySlot(resultRelInfo->ri_PlanSlots[resultRelInfo->ri_NumSlots],
+				 planSlot);
+
+	/*
+	 * If these are the first tuples stored in the buffers, add the target
+	 * rel and the mtstate to the es_insert_pending_result_relations and
+	 * es_insert_pending_modifytables lists respectively, except in the case
+	 * where flushing was done above, in which case they would already have
+	 * been added to the lists, so no need to do this.
+	 */
+	if (resultRelInfo->ri_NumSlots == 0 && !flushed)
+	{
+		Assert(!list_member_ptr(estate->es_insert_pending_result_relations,
+								resultRelInfo));
+		estate->es_insert_pending_result_relations =
+			lappend(estate->es_insert_pending_result_relations,
+					resultRelInfo);
+		estate->es_insert_pending_modifytables =
+			lappend(estate->es_insert_pending_modifytables, mtstate);
+	}
+	Assert(list_member_ptr(estate->es_insert_pending_result_relations,
+						   resultRelInfo));
+
+	resultRelInfo->ri_NumSlots++;
+
+	MemoryContextSwitchTo(oldContext);
+}
+
 /* ----------------------------------------------------------------
  *		ExecBatchInsert
  *
  *		Insert multiple tuples in an efficient way.
- *		Currently, this handles inserting into a foreign table without
- *		RETURNING clause.
+ *		For a foreign table, the tuples are handed to the FDW in a single
+ *		ExecForeignBatchInsert() call; for a plain table, they are inserted
+ *		with table_multi_insert() and the index entries added afterwards.
+ *		Only used for INSERT without a RETURNING clause.
  * ----------------------------------------------------------------
  */
 static void
@@ -1377,14 +1420,58 @@ ExecBatchInsert(ModifyTableState *mtstate,
 	TupleTableSlot *slot = NULL;
 	TupleTableSlot **rslots;
 
-	/*
-	 * insert into foreign table: let the FDW do it
-	 */
-	rslots = resultRelInfo->ri_FdwRoutine->ExecForeignBatchInsert(estate,
-																  resultRelInfo,
-																  slots,
-																  planSlots,
-																  &numInserted);
+	if (resultRelInfo->ri_FdwRoutine == NULL)
+	{
+		MemoryContext oldContext;
+
+		/*
+		 * table_multi_insert may leak memory, so switch to short-lived
+		 * memory context before calling it.
+		 */
+		oldContext = MemoryContextSwitchTo(GetPerTupleMemoryContext(estate));
+		table_multi_insert(resultRelInfo->ri_RelationDesc,
+						   slots,
+						   numSlots,
+						   estate->es_output_cid,
+						   0,
+						   NULL);
+		MemoryContextSwitchTo(oldContext);
+
+		/* insert index entries for the tuples */
+		if (resultRelInfo->ri_NumIndices > 0)
+		{
+			for (i = 0; i < numSlots; i++)
+			{
+				List	   *recheckIndexes;
+
+				recheckIndexes = ExecInsertIndexTuples(resultRelInfo,
+													   slots[i], estate,
+													   false, false, NULL,
+													   NIL, false);
+
+				/*
+				 * ExecInitModifyTable only enables batching when the result
+				 * relation has no triggers, so there's nothing to re-check
+				 * the indexes for later.
+				 */
+				Assert(recheckIndexes == NIL);
+				list_free(recheckIndexes);
+			}
+		}
+
+		rslots = slots;
+	}
+	else
+	{
+		/*
+		 * insert into foreign table: let the FDW do it
+		 */
+		rslots = resultRelInfo->ri_FdwRoutine->ExecForeignBatchInsert(estate,
+																	  resultRelInfo,
+																	  slots,
+																	  planSlots,
+																	  &numInserted);
+	}
 
 	for (i = 0; i < numInserted; i++)
 	{
@@ -1421,7 +1508,7 @@ ExecBatchInsert(ModifyTableState *mtstate,
 }
 
 /*
- * ExecPendingInserts -- flushes all pending inserts to the foreign tables
+ * ExecPendingInserts -- flushes all pending inserts to the target tables
  */
 static void
 ExecPendingInserts(EState *estate)
@@ -5137,9 +5224,14 @@ ExecInitModifyTable(ModifyTable *node, EState *estate, int eflags)
 		mtstate->mt_resultOidHash = NULL;
 
 	/*
-	 * Determine if the FDW supports batch insert and determine the batch size
-	 * (a FDW may support batching, but it may be disabled for the
-	 * server/table).
+	 * Determine if batch insert can be used and determine the batch size.
+	 * For a foreign table, the FDW decides (it may support batching, but it
+	 * may be disabled for the server/table).  For a plain table, we
+	 * accumulate rows and insert them with table_multi_insert, much as COPY
+	 * FROM does, provided nothing could observe the tuples before their
+	 * batch is flushed: that rules out triggers of any kind, RETURNING, and
+	 * ON CONFLICT processing.  Per-row work that precedes the insertion
+	 * proper (constraints, generated columns, RLS policies) is unaffected.
 	 *
 	 * We only do this for INSERT, so that for UPDATE/DELETE the batch size
 	 * remains set to 0.
@@ -5158,6 +5250,12 @@ ExecInitModifyTable(ModifyTable *node, EState *estate, int eflags)
 				resultRelInfo->ri_FdwRoutine->GetForeignModifyBatchSize(resultRelInfo);
 			Assert(resultRelInfo->ri_BatchSize >= 1);
 		}
+		else if (resultRelInfo->ri_FdwRoutine == NULL &&
+				 resultRelInfo->ri_RelationDesc->rd_rel->relkind == RELKIND_RELATION &&
+				 resultRelInfo->ri_TrigDesc == NULL &&
+				 node->onConflictAction == ONCONFLICT_NONE &&
+				 node->returningLists == NIL)
+			resultRelInfo->ri_BatchSize = MT_TABLE_INSERT_BATCH_SIZE;
 		else
 			resultRelInfo->ri_BatchSize = 1;
 	}
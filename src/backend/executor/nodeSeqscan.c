@@ -254,6 +254,12 @@ ExecInitSeqScan(SeqScan *node, EState *estate, int eflags)
 	scanstate->ss.ps.qual =
 		ExecInitQual(node->scan.plan.qual, (PlanState *) scanstate);
 
+	/*
+	 * Check whether the qual can be handled by the simple-comparison fast
+	 * path instead of the general expression machinery.
+	 */
+	ExecScanInitSimpleQual(&scanstate->ss);
+
 	/*
 	 * When EvalPlanQual() is not in use, assign ExecProcNode for this node
 	 * based on the presence of qual and projection. Each ExecSeqScan*()
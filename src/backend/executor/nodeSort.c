@@ -121,7 +121,18 @@ ExecSort(PlanState *pstate)
 												  NULL,
 												  tuplesortopts);
 		if (node->bounded)
+		{
 			tuplesort_set_bound(tuplesortstate, node->bound);
+
+			/*
+			 * If other participants of a parallel bounded sort are running
+			 * alongside us, cooperate with them on a shared leading-key
+			 * bound.
+			 */
+			if (node->shared_bound != NULL)
+				tuplesort_set_shared_bound(tuplesortstate,
+										   &node->shared_bound->bound_key);
+		}
 		node->tuplesortstate = tuplesortstate;
 
 		/*
@@ -417,12 +428,17 @@ ExecSortEstimate(SortState *node, ParallelContext *pcxt)
 {
 	Size		size;
 
-	/* don't need this if not instrumenting or no workers */
-	if (!node->ss.ps.instrument || pcxt->nworkers == 0)
+	/* needed when instrumenting or sharing a tuple bound, given workers */
+	if ((!node->ss.ps.instrument && !node->bounded) || pcxt->nworkers == 0)
 		return;
 
-	size = mul_size(pcxt->nworkers, sizeof(TuplesortInstrumentation));
-	size = add_size(size, offsetof(SharedSortInfo, sinstrument));
+	size = MAXALIGN(sizeof(SharedSortBound));
+	if (node->ss.ps.instrument)
+	{
+		size = add_size(size, mul_size(pcxt->nworkers,
+									   sizeof(TuplesortInstrumentation)));
+		size = add_size(size, offsetof(SharedSortInfo, sinstrument));
+	}
 	shm_toc_estimate_chunk(&pcxt->estimator, size);
 	shm_toc_estimate_keys(&pcxt->estimator, 1);
 }
@@ -436,20 +452,49 @@ ExecSortEstimate(SortState *node, ParallelContext *pcxt)
 void
 ExecSortInitializeDSM(SortState *node, ParallelContext *pcxt)
 {
+	SharedSortBound *sb;
 	Size		size;
 
-	/* don't need this if not instrumenting or no workers */
-	if (!node->ss.ps.instrument || pcxt->nworkers == 0)
+	/* needed when instrumenting or sharing a tuple bound, given workers */
+	if ((!node->ss.ps.instrument && !node->bounded) || pcxt->nworkers == 0)
 		return;
 
-	size = offsetof(SharedSortInfo, sinstrument)
-		+ pcxt->nworkers * sizeof(TuplesortInstrumentation);
-	node->shared_info = shm_toc_allocate(pcxt->toc, size);
-	/* ensure any unfilled slots will contain zeroes */
-	memset(node->shared_info, 0, size);
-	node->shared_info->num_workers = pcxt->nworkers;
-	shm_toc_insert(pcxt->toc, node->ss.ps.plan->plan_node_id,
-				   node->shared_info);
+	/*
+	 * The chunk always starts with a SharedSortBound; when instrumenting, a
+	 * SharedSortInfo follows it.
+	 */
+	size = MAXALIGN(sizeof(SharedSortBound));
+	if (node->ss.ps.instrument)
+		size += offsetof(SharedSortInfo, sinstrument)
+			+ pcxt->nworkers * sizeof(TuplesortInstrumentation);
+
+	sb = shm_toc_allocate(pcxt->toc, size);
+	/* ensure any unfilled instrumentation slots will contain zeroes */
+	memset(sb, 0, size);
+	sb->instrumented = (node->ss.ps.instrument != NULL);
+	pg_atomic_init_u64(&sb->bound_key, PG_UINT64_MAX);
+	node->shared_bound = sb;
+	if (sb->instrumented)
+	{
+		node->shared_info = (SharedSortInfo *)
+			((char *) sb + MAXALIGN(sizeof(SharedSortBound)));
+		node->shared_info->num_workers = pcxt->nworkers;
+	}
+	shm_toc_insert(pcxt->toc, node->ss.ps.plan->plan_node_id, sb);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecSortReInitializeDSM
+ *
+ *		Reset shared state before launching a fresh batch of workers.
+ * ----------------------------------------------------------------
+ */
+void
+ExecSortReInitializeDSM(SortState *node, ParallelContext *pcxt)
+{
+	/* any bound published during the previous scan no longer applies */
+	if (node->shared_bound != NULL)
+		pg_atomic_write_u64(&node->shared_bound->bound_key, PG_UINT64_MAX);
 }
 
 /* ----------------------------------------------------------------
@@ -461,8 +506,16 @@ ExecSortInitializeDSM(SortState *node, ParallelContext *pcxt)
 void
 ExecSortInitializeWorker(SortState *node, ParallelWorkerContext *pwcxt)
 {
-	node->shared_info =
-		shm_toc_lookup(pwcxt->toc, node->ss.ps.plan->plan_node_id, true);
+	SharedSortBound *sb;
+
+	sb = shm_toc_lookup(pwcxt->toc, node->ss.ps.plan->plan_node_id, true);
+	if (sb != NULL)
+	{
+		node->shared_bound = sb;
+		if (sb->instrumented)
+			node->shared_info = (SharedSortInfo *)
+				((char *) sb + MAXALIGN(sizeof(SharedSortBound)));
+	}
 	node->am_worker = true;
 }
 
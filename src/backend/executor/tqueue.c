@@ -54,16 +54,47 @@ static bool
 tqueueReceiveSlot(TupleTableSlot *slot, DestReceiver *self)
 {
 	TQueueDestReceiver *tqueue = (TQueueDestReceiver *) self;
-	MinimalTuple tuple;
 	shm_mq_result result;
-	bool		should_free;
 
-	/* Send the tuple itself. */
-	tuple = ExecFetchSlotMinimalTuple(slot, &should_free);
-	result = shm_mq_send(tqueue->queue, tuple->t_len, tuple, false, false);
+	/*
+	 * If the slot holds a heap tuple sitting in a buffer, send it without
+	 * materializing a minimal tuple copy first.  A minimal tuple is just the
+	 * heap tuple's data shifted by MINIMAL_TUPLE_OFFSET, with only the
+	 * length word and padding ahead of MINIMAL_TUPLE_DATA_OFFSET differing,
+	 * and shm_mq_sendv copies the payload into the ring buffer before
+	 * returning, so it's safe to pass references into the page while the
+	 * slot still holds the buffer pin.
+	 */
+	if (TTS_IS_BUFFERTUPLE(slot) && !TTS_EMPTY(slot) &&
+		((BufferHeapTupleTableSlot *) slot)->base.tuple != NULL)
+	{
+		HeapTuple	htup = ((BufferHeapTupleTableSlot *) slot)->base.tuple;
+		MinimalTupleData hdr;
+		shm_mq_iovec iov[2];
+
+		memset(&hdr, 0, MINIMAL_TUPLE_DATA_OFFSET);
+		hdr.t_len = htup->t_len - MINIMAL_TUPLE_OFFSET;
+
+		iov[0].data = (char *) &hdr;
+		iov[0].len = MINIMAL_TUPLE_DATA_OFFSET;
+		iov[1].data = (char *) htup->t_data + MINIMAL_TUPLE_OFFSET +
+			MINIMAL_TUPLE_DATA_OFFSET;
+		iov[1].len = hdr.t_len - MINIMAL_TUPLE_DATA_OFFSET;
 
-	if (should_free)
-		pfree(tuple);
+		result = shm_mq_sendv(tqueue->queue, iov, 2, false, false);
+	}
+	else
+	{
+		MinimalTuple tuple;
+		bool		should_free;
+
+		/* Send the tuple itself. */
+		tuple = ExecFetchSlotMinimalTuple(slot, &should_free);
+		result = shm_mq_send(tqueue->queue, tuple->t_len, tuple, false, false);
+
+		if (should_free)
+			pfree(tuple);
+	}
 
 	/* Check for failure. */
 	if (result == SHM_MQ_DETACHED)
@@ -245,6 +245,23 @@ llvm_create_context(int jitFlags)
 	return context;
 }
 
+/*
+ * Create a context for JITed code that is going to be kept for the whole
+ * backend lifetime, e.g. by the cross-query expression cache.  Such a
+ * context must not be released by end-of-query resource cleanup, so unhook
+ * it from the current resource owner.
+ */
+LLVMJitContext *
+llvm_create_cache_context(int jitFlags)
+{
+	LLVMJitContext *context = llvm_create_context(jitFlags);
+
+	ResourceOwnerForgetJIT(context->resowner, context);
+	context->resowner = NULL;
+
+	return context;
+}
+
 /*
  * Release resources required by one llvm context.
  */
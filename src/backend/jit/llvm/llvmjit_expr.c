@@ -22,6 +22,7 @@
 #include "access/nbtree.h"
 #include "catalog/objectaccess.h"
 #include "catalog/pg_type.h"
+#include "common/hashfn.h"
 #include "executor/execExpr.h"
 #include "executor/execdebug.h"
 #include "executor/nodeAgg.h"
@@ -39,6 +40,7 @@
 #include "utils/builtins.h"
 #include "utils/date.h"
 #include "utils/fmgrtab.h"
+#include "utils/hsearch.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/timestamp.h"
@@ -51,8 +53,44 @@ typedef struct CompiledExprState
 	const char *funcname;
 } CompiledExprState;
 
+/*
+ * Backend-local cache of compiled expressions, used when
+ * jit_cache_expressions is enabled.
+ *
+ * The code we generate bakes in quite a few compile-time constants,
+ * including the addresses of the expression's steps and of data structures
+ * they point to.  Reusing a compiled function for a different ExprState is
+ * therefore only safe when the function we would generate for it is
+ * identical to the cached one.  To guarantee that, the cache key is a hash
+ * over everything the generated code depends on - the state's flags, the
+ * location and length of the step array, and each step's opcode and
+ * payload - and a flat copy of that data is kept for an exact comparison on
+ * lookup.  This makes hits opportunistic (they require the allocator to
+ * have laid a rebuilt expression out identically, as commonly happens when
+ * a prepared statement's per-query context is rebuilt), but never unsound.
+ *
+ * Cached code lives in a dedicated JIT context that is not tied to a
+ * resource owner and survives until backend exit.  To bound the memory
+ * pinned that way, no new entries are added once the table has
+ * COMPILED_EXPR_CACHE_MAX_ENTRIES entries; existing entries can still hit.
+ */
+typedef struct CompiledExprCacheEntry
+{
+	uint64		key;			/* hash of signature, must be first */
+	char	   *signature;		/* flat copy of hashed data */
+	Size		signature_len;
+	LLVMJitContext *context;	/* cache-lifetime context holding the code */
+	const char *funcname;
+} CompiledExprCacheEntry;
+
+#define COMPILED_EXPR_CACHE_MAX_ENTRIES 128
+
+static HTAB *compiled_expr_cache = NULL;
+static LLVMJitContext *compiled_expr_cache_context = NULL;
+
 
 static Datum ExecRunCompiledExpr(ExprState *state, ExprContext *econtext, bool *isNull);
+static char *llvm_expr_signature(ExprState *state, Size *len);
 
 static LLVMValueRef BuildV1Call(LLVMJitContext *context, LLVMBuilderRef b,
 								LLVMModuleRef mod, FunctionCallInfo fcinfo,
@@ -132,6 +170,11 @@ llvm_compile_expr(ExprState *state)
 	instr_time	endtime;
 	instr_time	deform_endtime;
 
+	char	   *signature = NULL;
+	Size		signature_len = 0;
+	uint64		cache_key = 0;
+	bool		cache_insert = false;
+
 	llvm_enter_fatal_on_oom();
 
 	/*
@@ -140,8 +183,72 @@ llvm_compile_expr(ExprState *state)
 	 */
 	Assert(parent);
 
+	/*
+	 * If enabled, check whether we've already compiled an identical
+	 * expression; on a hit we can skip all LLVM work.
+	 */
+	if (jit_cache_expressions)
+	{
+		CompiledExprCacheEntry *entry;
+		bool		found;
+
+		if (compiled_expr_cache == NULL)
+		{
+			HASHCTL		ctl;
+
+			ctl.keysize = sizeof(uint64);
+			ctl.entrysize = sizeof(CompiledExprCacheEntry);
+			ctl.hcxt = TopMemoryContext;
+			compiled_expr_cache = hash_create("compiled expression cache",
+											  COMPILED_EXPR_CACHE_MAX_ENTRIES,
+											  &ctl,
+											  HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+		}
+
+		signature = llvm_expr_signature(state, &signature_len);
+		cache_key = hash_bytes_extended((const unsigned char *) signature,
+										signature_len, 0);
+
+		entry = hash_search(compiled_expr_cache, &cache_key,
+							HASH_FIND, &found);
+		if (found &&
+			entry->signature_len == signature_len &&
+			memcmp(entry->signature, signature, signature_len) == 0)
+		{
+			CompiledExprState *cstate = palloc0(sizeof(CompiledExprState));
+
+			cstate->context = entry->context;
+			cstate->funcname = entry->funcname;
+
+			state->evalfunc = ExecRunCompiledExpr;
+			state->evalfunc_private = cstate;
+
+			llvm_leave_fatal_on_oom();
+
+			return true;
+		}
+
+		/* don't cache over a hash collision with a different signature */
+		cache_insert = !found &&
+			hash_get_num_entries(compiled_expr_cache) < COMPILED_EXPR_CACHE_MAX_ENTRIES;
+	}
+
 	/* get or create JIT context */
-	if (parent->state->es_jit)
+	if (cache_insert)
+	{
+		/*
+		 * Compile into the cache's own long-lived context, so that the code
+		 * survives end-of-query resource cleanup.  The context is created
+		 * with the first cached expression's flags; differing flags only
+		 * affect optimization effort, not semantics, and are part of the
+		 * cache signature anyway.
+		 */
+		if (compiled_expr_cache_context == NULL)
+			compiled_expr_cache_context =
+				llvm_create_cache_context(parent->state->es_jit_flags);
+		context = compiled_expr_cache_context;
+	}
+	else if (parent->state->es_jit)
 		context = (LLVMJitContext *) parent->state->es_jit;
 	else
 	{
@@ -2965,6 +3072,22 @@ llvm_compile_expr(ExprState *state)
 		state->evalfunc_private = cstate;
 	}
 
+	/* remember the compiled expression for reuse by later queries */
+	if (cache_insert)
+	{
+		CompiledExprCacheEntry *entry;
+		bool		found;
+
+		entry = hash_search(compiled_expr_cache, &cache_key,
+							HASH_ENTER, &found);
+		Assert(!found);
+		entry->signature = MemoryContextAlloc(TopMemoryContext, signature_len);
+		memcpy(entry->signature, signature, signature_len);
+		entry->signature_len = signature_len;
+		entry->context = context;
+		entry->funcname = MemoryContextStrdup(TopMemoryContext, funcname);
+	}
+
 	llvm_leave_fatal_on_oom();
 
 	INSTR_TIME_SET_CURRENT(endtime);
@@ -3002,6 +3125,159 @@ ExecRunCompiledExpr(ExprState *state, ExprContext *econtext, bool *isNull)
 	return func(state, econtext, isNull);
 }
 
+/*
+ * Build a flat representation of everything the code generated for "state"
+ * would depend on, for use by the compiled-expression cache.
+ *
+ * This must cover every compile-time constant that code generation bakes
+ * into the emitted function: the state's flags, the identity of the parent
+ * node, the address and length of the step array, and each step's opcode,
+ * result locations and payload.  Padding bytes inside the step union may be
+ * uninitialized; that can only cause false cache misses, never false hits,
+ * since lookups compare the full signature.
+ *
+ * For steps whose payload contains pointers to structures whose *contents*
+ * are baked into the emitted code, the raw pointer is not a sufficient
+ * identity: the structure could be rebuilt at a recycled address with
+ * different contents.  Such steps must append the relevant contents as well.
+ * That's the FETCHSOME steps, whose known_desc tuple descriptor determines
+ * the layout of the generated deforming code, and every step that emits a
+ * function call, where the called function's symbol is resolved from the
+ * FmgrInfo's fn_oid/fn_addr and its strictness shapes the generated
+ * null-argument handling.
+ *
+ * The result is palloc'd in the current memory context.
+ */
+
+/*
+ * Append the identity of a to-be-called function, i.e. everything
+ * llvm_function_reference() and the strictness checks specialize the
+ * emitted code on.
+ */
+static void
+llvm_expr_signature_func(StringInfo buf, FunctionCallInfo fcinfo)
+{
+	FmgrInfo   *flinfo = fcinfo->flinfo;
+
+	appendBinaryStringInfo(buf, (const char *) &flinfo->fn_oid,
+						   sizeof(flinfo->fn_oid));
+	appendBinaryStringInfo(buf, (const char *) &flinfo->fn_addr,
+						   sizeof(flinfo->fn_addr));
+	appendBinaryStringInfo(buf, (const char *) &flinfo->fn_strict,
+						   sizeof(flinfo->fn_strict));
+	appendBinaryStringInfo(buf, (const char *) &fcinfo->nargs,
+						   sizeof(fcinfo->nargs));
+}
+
+static char *
+llvm_expr_signature(ExprState *state, Size *len)
+{
+	StringInfoData buf;
+	int			jit_flags = state->parent->state->es_jit_flags;
+
+	initStringInfo(&buf);
+
+	appendBinaryStringInfo(&buf, (const char *) &state->flags,
+						   sizeof(state->flags));
+	appendBinaryStringInfo(&buf, (const char *) &state->parent,
+						   sizeof(state->parent));
+	appendBinaryStringInfo(&buf, (const char *) &jit_flags,
+						   sizeof(jit_flags));
+	appendBinaryStringInfo(&buf, (const char *) &state->steps,
+						   sizeof(state->steps));
+	appendBinaryStringInfo(&buf, (const char *) &state->steps_len,
+						   sizeof(state->steps_len));
+
+	for (int opno = 0; opno < state->steps_len; opno++)
+	{
+		ExprEvalStep *op = &state->steps[opno];
+		ExprEvalOp	opcode = ExecEvalStepOp(state, op);
+
+		appendBinaryStringInfo(&buf, (const char *) &opcode, sizeof(opcode));
+		appendBinaryStringInfo(&buf, (const char *) &op->resvalue,
+							   sizeof(op->resvalue));
+		appendBinaryStringInfo(&buf, (const char *) &op->resnull,
+							   sizeof(op->resnull));
+		appendBinaryStringInfo(&buf, (const char *) &op->d, sizeof(op->d));
+
+		switch (opcode)
+		{
+			case EEOP_INNER_FETCHSOME:
+			case EEOP_OUTER_FETCHSOME:
+			case EEOP_SCAN_FETCHSOME:
+			case EEOP_OLD_FETCHSOME:
+			case EEOP_NEW_FETCHSOME:
+				if (op->d.fetch.known_desc)
+				{
+					TupleDesc	desc = op->d.fetch.known_desc;
+
+					/*
+					 * slot_compile_deform() specializes the generated code to
+					 * the descriptor's attribute count and each attribute's
+					 * layout, so those have to match, not just the pointer.
+					 */
+					appendBinaryStringInfo(&buf, (const char *) &desc->natts,
+										   sizeof(desc->natts));
+					for (int attno = 0; attno < desc->natts; attno++)
+						appendBinaryStringInfo(&buf,
+											   (const char *) TupleDescAttr(desc, attno),
+											   ATTRIBUTE_FIXED_PART_SIZE);
+				}
+				break;
+
+			case EEOP_FUNCEXPR:
+			case EEOP_FUNCEXPR_STRICT:
+			case EEOP_FUNCEXPR_STRICT_1:
+			case EEOP_FUNCEXPR_STRICT_2:
+			case EEOP_FUNCEXPR_FUSAGE:
+			case EEOP_FUNCEXPR_STRICT_FUSAGE:
+			case EEOP_DISTINCT:
+			case EEOP_NOT_DISTINCT:
+			case EEOP_NULLIF:
+				llvm_expr_signature_func(&buf, op->d.func.fcinfo_data);
+				break;
+
+			case EEOP_IOCOERCE:
+				llvm_expr_signature_func(&buf, op->d.iocoerce.fcinfo_data_out);
+				llvm_expr_signature_func(&buf, op->d.iocoerce.fcinfo_data_in);
+				break;
+
+			case EEOP_ROWCOMPARE_STEP:
+				llvm_expr_signature_func(&buf, op->d.rowcompare_step.fcinfo_data);
+				break;
+
+			case EEOP_HASHDATUM_FIRST:
+			case EEOP_HASHDATUM_FIRST_STRICT:
+			case EEOP_HASHDATUM_NEXT32:
+			case EEOP_HASHDATUM_NEXT32_STRICT:
+				llvm_expr_signature_func(&buf, op->d.hashdatum.fcinfo_data);
+				break;
+
+			case EEOP_AGG_STRICT_DESERIALIZE:
+			case EEOP_AGG_DESERIALIZE:
+				llvm_expr_signature_func(&buf, op->d.agg_deserialize.fcinfo_data);
+				break;
+
+			case EEOP_AGG_PLAIN_TRANS_INIT_STRICT_BYVAL:
+			case EEOP_AGG_PLAIN_TRANS_STRICT_BYVAL:
+			case EEOP_AGG_PLAIN_TRANS_BYVAL:
+			case EEOP_AGG_PLAIN_TRANS_INIT_STRICT_BYREF:
+			case EEOP_AGG_PLAIN_TRANS_STRICT_BYREF:
+			case EEOP_AGG_PLAIN_TRANS_BYREF:
+				/* the transition call is emitted from the pertrans' fcinfo */
+				llvm_expr_signature_func(&buf,
+										 op->d.agg_trans.pertrans->transfn_fcinfo);
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	*len = buf.len;
+	return buf.data;
+}
+
 static LLVMValueRef
 BuildV1Call(LLVMJitContext *context, LLVMBuilderRef b,
 			LLVMModuleRef mod, FunctionCallInfo fcinfo,
@@ -224,6 +224,50 @@ pairingheap_remove(pairingheap *heap, pairingheap_node *node)
 	}
 }
 
+/*
+ * pairingheap_promote
+ *
+ * Notify the heap that 'node' now sorts closer to the root than it used to,
+ * i.e. that its value has increased if this is a max-heap.  The node is
+ * detached together with its children -- which were smaller than the node
+ * before the change, and therefore still are -- and melded back into the
+ * heap as a new tree.  O(1) worst case.
+ *
+ * This must not be used if the node's value might have moved in the other
+ * direction; remove and re-add the node in that case.
+ */
+void
+pairingheap_promote(pairingheap *heap, pairingheap_node *node)
+{
+	pairingheap_node *next_sibling;
+	pairingheap_node **prev_ptr;
+
+	/* The root has no parent it could violate the heap property with. */
+	if (node == heap->ph_root)
+		return;
+
+	/*
+	 * Find the pointer to the node in its previous sibling, or if this is the
+	 * first child of its parent, in its parent, and unlink the node from the
+	 * sibling list.
+	 */
+	next_sibling = node->next_sibling;
+	if (node->prev_or_parent->first_child == node)
+		prev_ptr = &node->prev_or_parent->first_child;
+	else
+		prev_ptr = &node->prev_or_parent->next_sibling;
+	Assert(*prev_ptr == node);
+
+	*prev_ptr = next_sibling;
+	if (next_sibling)
+		next_sibling->prev_or_parent = node->prev_or_parent;
+
+	/* Link the detached subheap back in as a new tree. */
+	heap->ph_root = merge(heap, heap->ph_root, node);
+	heap->ph_root->prev_or_parent = NULL;
+	heap->ph_root->next_sibling = NULL;
+}
+
 /*
  * Merge a list of subheaps into a single heap.
  *
@@ -281,6 +281,18 @@ be_tls_init(bool isServerStart)
 	SSL_CTX_set_options(context, SSL_OP_NO_CLIENT_RENEGOTIATION);
 #endif
 
+	/*
+	 * Request kernel TLS offload for established sessions if enabled.  This
+	 * is strictly best-effort: OpenSSL hands record processing to the kernel
+	 * only when the library build, the kernel and the negotiated cipher all
+	 * support it, and otherwise falls back to userspace crypto silently.
+	 * SSL_OP_ENABLE_KTLS is available since OpenSSL 3.0.
+	 */
+#ifdef SSL_OP_ENABLE_KTLS
+	if (SSLKernelTLS)
+		SSL_CTX_set_options(context, SSL_OP_ENABLE_KTLS);
+#endif
+
 	/* set up ephemeral DH and ECDH keys */
 	if (!initialize_dh(context, isServerStart))
 		goto error;
@@ -1131,6 +1131,20 @@ pq_buffer_remaining_data(void)
 	return (PqRecvLength - PqRecvPointer);
 }
 
+/* --------------------------------
+ *		pq_send_pending_data	- return number of unsent bytes in send buffer
+ *
+ * This will *not* attempt to send anything; it just reports how much data
+ * has been buffered but not yet handed to the socket.
+ * --------------------------------
+ */
+ssize_t
+pq_send_pending_data(void)
+{
+	Assert(PqSendPointer >= PqSendStart);
+	return (PqSendPointer - PqSendStart);
+}
+
 
 /* --------------------------------
  *		pq_startmsgread - begin reading a message from the client.
@@ -29,6 +29,7 @@
 
 #include "miscadmin.h"
 #include "port/pg_bitutils.h"
+#include "port/pg_numa.h"
 #include "portability/mem.h"
 #include "storage/dsm.h"
 #include "storage/fd.h"
@@ -663,6 +664,20 @@ CreateAnonymousSegment(Size *size)
 						 allocsize) : 0));
 	}
 
+	/*
+	 * If requested, ask the kernel to interleave the segment's pages across
+	 * all NUMA nodes.  Under the default first-touch policy most of the
+	 * segment - notably the buffer pool - is otherwise placed on whichever
+	 * node faults it in first, leaving backends on other nodes with uniformly
+	 * remote access.  This must happen before anything touches the memory,
+	 * since an interleaving policy only applies to pages not yet faulted in.
+	 */
+	if (numa_interleave && pg_numa_interleave_memory(ptr, allocsize) < 0)
+		ereport(FATAL,
+				(errmsg("could not interleave shared memory across NUMA nodes"),
+				 errhint("\"numa_interleave\" requires NUMA support, and the server "
+						 "must be built with libnuma.")));
+
 	*size = allocsize;
 	return ptr;
 }
@@ -66,6 +66,7 @@
 #include <sys/time.h>
 #include <unistd.h>
 
+#include "access/hash.h"
 #include "access/heapam.h"
 #include "access/htup_details.h"
 #include "access/multixact.h"
@@ -196,6 +197,20 @@ typedef struct av_relation
 								 * reloptions, or NULL if none */
 } av_relation;
 
+/*
+ * struct to track a single relation that the pg_class scan found in need of
+ * vacuum and/or analyze, together with how urgent the work is.  The list of
+ * these is sorted so that the most pressing tables are processed first,
+ * instead of in pg_class physical order.
+ */
+typedef struct av_candidate
+{
+	Oid			ac_relid;
+	bool		ac_wraparound;	/* vacuum needed to prevent wraparound? */
+	uint32		ac_age;			/* age of relfrozenxid/relminmxid */
+	PgStat_Counter ac_deadtuples;	/* dead tuples, according to pgstat */
+} av_candidate;
+
 /* struct to keep track of tables to vacuum and/or analyze, after rechecking */
 typedef struct autovac_table
 {
@@ -327,6 +342,10 @@ static void rebuild_database_list(Oid newdb);
 static int	db_comparator(const void *a, const void *b);
 static void autovac_recalculate_workers_for_balance(void);
 
+static av_candidate *av_build_candidate(Oid relid, Form_pg_class classForm,
+										PgStat_StatTabEntry *tabentry,
+										bool wraparound);
+static int	av_candidate_comparator(const ListCell *a, const ListCell *b);
 static void do_autovacuum(void);
 static void FreeWorkerInfo(int code, Datum arg);
 
@@ -1875,6 +1894,51 @@ get_database_list(void)
 	return dblist;
 }
 
+/*
+ * Build an av_candidate for a relation that the pg_class scan determined to
+ * need work, capturing the information used to prioritize it.
+ */
+static av_candidate *
+av_build_candidate(Oid relid, Form_pg_class classForm,
+				   PgStat_StatTabEntry *tabentry, bool wraparound)
+{
+	av_candidate *candidate = palloc(sizeof(av_candidate));
+	uint32		xid_age = 0;
+	uint32		multi_age = 0;
+
+	if (TransactionIdIsNormal(classForm->relfrozenxid))
+		xid_age = (uint32) (recentXid - classForm->relfrozenxid);
+	if (MultiXactIdIsValid(classForm->relminmxid))
+		multi_age = (uint32) (recentMulti - classForm->relminmxid);
+
+	candidate->ac_relid = relid;
+	candidate->ac_wraparound = wraparound;
+	candidate->ac_age = Max(xid_age, multi_age);
+	candidate->ac_deadtuples = tabentry ? tabentry->dead_tuples : 0;
+
+	return candidate;
+}
+
+/*
+ * qsort comparator for av_candidate lists: relations needing vacuum to
+ * prevent XID or multixact wraparound come first, oldest first; the rest are
+ * ordered by their number of dead tuples.
+ */
+static int
+av_candidate_comparator(const ListCell *a, const ListCell *b)
+{
+	const av_candidate *ca = (const av_candidate *) lfirst(a);
+	const av_candidate *cb = (const av_candidate *) lfirst(b);
+
+	if (ca->ac_wraparound != cb->ac_wraparound)
+		return ca->ac_wraparound ? -1 : 1;
+	if (ca->ac_wraparound && ca->ac_age != cb->ac_age)
+		return (ca->ac_age > cb->ac_age) ? -1 : 1;
+	if (ca->ac_deadtuples != cb->ac_deadtuples)
+		return (ca->ac_deadtuples > cb->ac_deadtuples) ? -1 : 1;
+	return 0;
+}
+
 /*
  * Process a database table-by-table
  *
@@ -1888,7 +1952,7 @@ do_autovacuum(void)
 	HeapTuple	tuple;
 	TableScanDesc relScan;
 	Form_pg_database dbForm;
-	List	   *table_oids = NIL;
+	List	   *table_candidates = NIL;
 	List	   *orphan_oids = NIL;
 	HASHCTL		ctl;
 	HTAB	   *table_toast_map;
@@ -2042,9 +2106,12 @@ do_autovacuum(void)
 								  effective_multixact_freeze_max_age,
 								  &dovacuum, &doanalyze, &wraparound);
 
-		/* Relations that need work are added to table_oids */
+		/* Relations that need work are added to table_candidates */
 		if (dovacuum || doanalyze)
-			table_oids = lappend_oid(table_oids, relid);
+			table_candidates = lappend(table_candidates,
+									   av_build_candidate(relid, classForm,
+														  tabentry,
+														  wraparound));
 
 		/*
 		 * Remember TOAST associations for the second pass.  Note: we must do
@@ -2136,7 +2203,10 @@ do_autovacuum(void)
 
 		/* ignore analyze for toast tables */
 		if (dovacuum)
-			table_oids = lappend_oid(table_oids, relid);
+			table_candidates = lappend(table_candidates,
+									   av_build_candidate(relid, classForm,
+														  tabentry,
+														  wraparound));
 
 		/* Release stuff to avoid leakage */
 		if (free_relopts)
@@ -2285,12 +2355,23 @@ do_autovacuum(void)
 										  "Autovacuum Portal",
 										  ALLOCSET_DEFAULT_SIZES);
 
+	/*
+	 * Sort the candidates so that the most urgent work comes first:
+	 * relations that need vacuuming to prevent transaction ID or multixact
+	 * ID wraparound are processed before anything else, oldest first, and
+	 * the remainder are ordered by their number of dead tuples.  Otherwise
+	 * we'd process tables in pg_class physical order, and a long series of
+	 * merely bloated tables could delay work on a table whose relfrozenxid
+	 * is approaching the wraparound horizon.
+	 */
+	list_sort(table_candidates, av_candidate_comparator);
+
 	/*
 	 * Perform operations on collected tables.
 	 */
-	foreach(cell, table_oids)
+	foreach(cell, table_candidates)
 	{
-		Oid			relid = lfirst_oid(cell);
+		Oid			relid = ((av_candidate *) lfirst(cell))->ac_relid;
 		HeapTuple	classTup;
 		autovac_table *tab;
 		bool		isshared;
@@ -2521,7 +2602,7 @@ deleted:
 		pg_atomic_test_set_flag(&MyWorkerInfo->wi_dobalance);
 	}
 
-	list_free(table_oids);
+	list_free_deep(table_candidates);
 
 	/*
 	 * Perform additional work items, as requested by backends.
@@ -2650,6 +2731,13 @@ perform_work_item(AutoVacuumWorkItem *workitem)
 									ObjectIdGetDatum(workitem->avw_relation),
 									Int64GetDatum((int64) workitem->avw_blockNumber));
 				break;
+			case AVW_GINCleanPendingList:
+				DirectFunctionCall1(gin_clean_pending_list,
+									ObjectIdGetDatum(workitem->avw_relation));
+				break;
+			case AVW_HashExpandTable:
+				_hash_expand_workitem(workitem->avw_relation);
+				break;
 			default:
 				elog(WARNING, "unrecognized work item found: type %d",
 					 workitem->avw_type);
@@ -3255,6 +3343,14 @@ autovac_report_workitem(AutoVacuumWorkItem *workitem,
 			snprintf(activity, MAX_AUTOVAC_ACTIV_LEN,
 					 "autovacuum: BRIN summarize");
 			break;
+		case AVW_GINCleanPendingList:
+			snprintf(activity, MAX_AUTOVAC_ACTIV_LEN,
+					 "autovacuum: GIN pending list cleanup");
+			break;
+		case AVW_HashExpandTable:
+			snprintf(activity, MAX_AUTOVAC_ACTIV_LEN,
+					 "autovacuum: hash index expansion");
+			break;
 	}
 
 	/*
@@ -3302,6 +3398,28 @@ AutoVacuumRequestWork(AutoVacuumWorkItemType type, Oid relationId,
 
 	LWLockAcquire(AutovacuumLock, LW_EXCLUSIVE);
 
+	/*
+	 * If an identical request is already queued, report success without
+	 * adding another copy.  Requesters may notice the same condition over
+	 * and over until a worker gets around to the item (for instance, every
+	 * insert into a GIN index whose pending list is over the cleanup
+	 * threshold), and duplicates would just crowd out other requests.
+	 */
+	for (i = 0; i < NUM_WORKITEMS; i++)
+	{
+		AutoVacuumWorkItem *workitem = &AutoVacuumShmem->av_workItems[i];
+
+		if (workitem->avw_used && !workitem->avw_active &&
+			workitem->avw_type == type &&
+			workitem->avw_database == MyDatabaseId &&
+			workitem->avw_relation == relationId &&
+			workitem->avw_blockNumber == blkno)
+		{
+			LWLockRelease(AutovacuumLock);
+			return true;
+		}
+	}
+
 	/*
 	 * Locate an unused work item and fill it with the given data.
 	 */
@@ -97,6 +97,7 @@
 #include "access/xlog_internal.h"
 #include "catalog/catalog.h"
 #include "common/int.h"
+#include "common/pg_lzcompress.h"
 #include "lib/binaryheap.h"
 #include "miscadmin.h"
 #include "pgstat.h"
@@ -190,10 +191,26 @@ typedef struct ReorderBufferToastEnt
 typedef struct ReorderBufferDiskChange
 {
 	Size		size;
+
+	/*
+	 * If rawsize is zero the data following the header is stored verbatim;
+	 * otherwise it is pglz-compressed and expands to rawsize bytes.  Spill
+	 * files never survive a restart, so there's no on-disk compatibility to
+	 * worry about.
+	 */
+	Size		rawsize;
+
 	ReorderBufferChange change;
 	/* data follows */
 } ReorderBufferDiskChange;
 
+/*
+ * Minimum payload size for which we attempt to compress a spilled change.
+ * Payloads smaller than this are unlikely to shrink enough to be worth the
+ * cycles (and pglz refuses very small inputs anyway).
+ */
+#define REORDER_BUFFER_SPILL_COMPRESS_MIN 64
+
 #define IsSpecInsert(action) \
 ( \
 	((action) == REORDER_BUFFER_CHANGE_INTERNAL_SPEC_INSERT) \
@@ -379,6 +396,8 @@ ReorderBufferAllocate(void)
 
 	buffer->outbuf = NULL;
 	buffer->outbufsize = 0;
+	buffer->cmpbuf = NULL;
+	buffer->cmpbufsize = 0;
 	buffer->size = 0;
 
 	/* txn_heap is ordered by transaction size */
@@ -3406,10 +3425,16 @@ ReorderBufferChangeMemoryUpdate(ReorderBuffer *rb,
 		/* Update the total size in the top transaction. */
 		toptxn->total_size += sz;
 
-		/* Update the max-heap */
+		/*
+		 * Update the max-heap.  Since the transaction can only have grown, it
+		 * is enough to let it bubble up towards the root, which the pairing
+		 * heap does in constant time; a full remove-and-add would cost
+		 * O(log n) amortized for every change queued.
+		 */
 		if (oldsize != 0)
-			pairingheap_remove(rb->txn_heap, &txn->txn_node);
-		pairingheap_add(rb->txn_heap, &txn->txn_node);
+			pairingheap_promote(rb->txn_heap, &txn->txn_node);
+		else
+			pairingheap_add(rb->txn_heap, &txn->txn_node);
 	}
 	else
 	{
@@ -3770,6 +3795,24 @@ ReorderBufferSerializeReserve(ReorderBuffer *rb, Size sz)
 	}
 }
 
+/*
+ * Enlarge the compression scratch buffer, as needed.
+ */
+static void
+ReorderBufferCompressReserve(ReorderBuffer *rb, Size sz)
+{
+	if (!rb->cmpbufsize)
+	{
+		rb->cmpbuf = MemoryContextAlloc(rb->context, sz);
+		rb->cmpbufsize = sz;
+	}
+	else if (rb->cmpbufsize < sz)
+	{
+		rb->cmpbuf = repalloc(rb->cmpbuf, sz);
+		rb->cmpbufsize = sz;
+	}
+}
+
 
 /* Compare two transactions by size */
 static int
@@ -4236,6 +4279,31 @@ ReorderBufferSerializeChange(ReorderBuffer *rb, ReorderBufferTXN *txn,
 	}
 
 	ondisk->size = sz;
+	ondisk->rawsize = 0;
+
+	/*
+	 * Try to compress sizable payloads -- in practice mostly the tuple data
+	 * of DML changes -- before they hit disk.  Large transactions can spill
+	 * many times their WAL volume, so this pays for itself quickly.  If pglz
+	 * can't shrink the payload, store it verbatim.
+	 */
+	if (sz - sizeof(ReorderBufferDiskChange) >= REORDER_BUFFER_SPILL_COMPRESS_MIN &&
+		sz - sizeof(ReorderBufferDiskChange) < PG_INT32_MAX)
+	{
+		Size		rawlen = sz - sizeof(ReorderBufferDiskChange);
+		int32		complen;
+
+		ReorderBufferCompressReserve(rb, PGLZ_MAX_OUTPUT(rawlen));
+		complen = pglz_compress(rb->outbuf + sizeof(ReorderBufferDiskChange),
+								rawlen, rb->cmpbuf, PGLZ_strategy_default);
+		if (complen >= 0 && (Size) complen < rawlen)
+		{
+			memcpy(rb->outbuf + sizeof(ReorderBufferDiskChange),
+				   rb->cmpbuf, complen);
+			ondisk->size = sizeof(ReorderBufferDiskChange) + complen;
+			ondisk->rawsize = rawlen;
+		}
+	}
 
 	errno = 0;
 	pgstat_report_wait_start(WAIT_EVENT_REORDER_BUFFER_WRITE);
@@ -4630,6 +4698,28 @@ ReorderBufferRestoreChanges(ReorderBuffer *rb, ReorderBufferTXN *txn,
 
 		file->curOffset += readBytes;
 
+		/* decompress the payload, if it was stored compressed */
+		if (ondisk->rawsize > 0)
+		{
+			Size		rawlen = ondisk->rawsize;
+			Size		complen = ondisk->size - sizeof(ReorderBufferDiskChange);
+
+			ReorderBufferCompressReserve(rb, rawlen);
+			if (pglz_decompress(rb->outbuf + sizeof(ReorderBufferDiskChange),
+								complen, rb->cmpbuf, rawlen, true) != (int32) rawlen)
+				ereport(ERROR,
+						(errcode(ERRCODE_DATA_CORRUPTED),
+						 errmsg("invalid compressed data in reorderbuffer spill file")));
+
+			ReorderBufferSerializeReserve(rb,
+										  sizeof(ReorderBufferDiskChange) + rawlen);
+			ondisk = (ReorderBufferDiskChange *) rb->outbuf;
+			memcpy(rb->outbuf + sizeof(ReorderBufferDiskChange),
+				   rb->cmpbuf, rawlen);
+			ondisk->size = sizeof(ReorderBufferDiskChange) + rawlen;
+			ondisk->rawsize = 0;
+		}
+
 		/*
 		 * ok, read a full change from disk, now restore it into proper
 		 * in-memory format
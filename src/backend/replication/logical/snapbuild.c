@@ -1564,12 +1564,26 @@ SnapBuildSerialize(SnapBuild *builder, XLogRecPtr lsn)
 	}
 
 	/*
-	 * there is an obvious race condition here between the time we stat(2) the
-	 * file and us writing the file. But we rename the file into place
-	 * atomically and all files created need to contain the same data anyway,
-	 * so this is perfectly fine, although a bit of a resource waste. Locking
-	 * seems like pointless complication.
+	 * Take the lock before writing.  When several walsenders decode the same
+	 * xl_running_xacts record at roughly the same time -- the usual case when
+	 * they are all caught up -- they would each write, sync and rename their
+	 * own copy of the same snapshot, all but one thrown away by the rename.
+	 * Serializing the writers lets the losers reuse the winner's work.
 	 */
+	LWLockAcquire(LogicalSnapshotWriteLock, LW_EXCLUSIVE);
+
+	/*
+	 * Re-check under the lock.  If the file exists now, whoever created it
+	 * completed the fsyncs below before releasing the lock, so unlike in the
+	 * unlocked check above there is no need to repeat them.
+	 */
+	if (stat(path, &stat_buf) == 0)
+	{
+		LWLockRelease(LogicalSnapshotWriteLock);
+		builder->last_serialized_snapshot = lsn;
+		goto out;
+	}
+
 	elog(DEBUG1, "serializing snapshot to %s", path);
 
 	/* to make sure only we will write to this tempfile, include pid */
@@ -1713,6 +1727,8 @@ SnapBuildSerialize(SnapBuild *builder, XLogRecPtr lsn)
 	fsync_fname(path, false);
 	fsync_fname(PG_LOGICAL_SNAPSHOTS_DIR, true);
 
+	LWLockRelease(LogicalSnapshotWriteLock);
+
 	/*
 	 * Now there's no way we can lose the dumped state anymore, remember this
 	 * as a serialization point.
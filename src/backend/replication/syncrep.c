@@ -84,6 +84,7 @@
 #include "storage/proc.h"
 #include "tcop/tcopprot.h"
 #include "utils/guc_hooks.h"
+#include "utils/memutils.h"
 #include "utils/ps_status.h"
 
 /* User-settable parameters for sync rep */
@@ -99,7 +100,8 @@ static int	SyncRepWaitMode = SYNC_REP_NO_WAIT;
 
 static void SyncRepQueueInsert(int mode);
 static void SyncRepCancelWait(void);
-static int	SyncRepWakeQueue(bool all, int mode);
+static Latch **SyncRepWakeupArray(void);
+static int	SyncRepWakeQueue(bool all, int mode, Latch **latches);
 
 static bool SyncRepGetSyncRecPtr(XLogRecPtr *writePtr,
 								 XLogRecPtr *flushPtr,
@@ -482,6 +484,9 @@ SyncRepReleaseWaiters(void)
 	int			numwrite = 0;
 	int			numflush = 0;
 	int			numapply = 0;
+	Latch	  **latches;
+	int			numlatches = 0;
+	int			i;
 
 	/*
 	 * If this WALSender is serving a standby that is not on the list of
@@ -503,6 +508,8 @@ SyncRepReleaseWaiters(void)
 	 * We're a potential sync standby. Release waiters if there are enough
 	 * sync standbys and we are considered as sync.
 	 */
+	latches = SyncRepWakeupArray();
+
 	LWLockAcquire(SyncRepLock, LW_EXCLUSIVE);
 
 	/*
@@ -551,21 +558,31 @@ SyncRepReleaseWaiters(void)
 	if (walsndctl->lsn[SYNC_REP_WAIT_WRITE] < writePtr)
 	{
 		walsndctl->lsn[SYNC_REP_WAIT_WRITE] = writePtr;
-		numwrite = SyncRepWakeQueue(false, SYNC_REP_WAIT_WRITE);
+		numwrite = SyncRepWakeQueue(false, SYNC_REP_WAIT_WRITE,
+									latches + numlatches);
+		numlatches += numwrite;
 	}
 	if (walsndctl->lsn[SYNC_REP_WAIT_FLUSH] < flushPtr)
 	{
 		walsndctl->lsn[SYNC_REP_WAIT_FLUSH] = flushPtr;
-		numflush = SyncRepWakeQueue(false, SYNC_REP_WAIT_FLUSH);
+		numflush = SyncRepWakeQueue(false, SYNC_REP_WAIT_FLUSH,
+									latches + numlatches);
+		numlatches += numflush;
 	}
 	if (walsndctl->lsn[SYNC_REP_WAIT_APPLY] < applyPtr)
 	{
 		walsndctl->lsn[SYNC_REP_WAIT_APPLY] = applyPtr;
-		numapply = SyncRepWakeQueue(false, SYNC_REP_WAIT_APPLY);
+		numapply = SyncRepWakeQueue(false, SYNC_REP_WAIT_APPLY,
+									latches + numlatches);
+		numlatches += numapply;
 	}
 
 	LWLockRelease(SyncRepLock);
 
+	/* Now that the lock is released, wake the released waiters. */
+	for (i = 0; i < numlatches; i++)
+		SetLatch(latches[i]);
+
 	elog(DEBUG3, "released %d procs up to write %X/%08X, %d procs up to flush %X/%08X, %d procs up to apply %X/%08X",
 		 numwrite, LSN_FORMAT_ARGS(writePtr),
 		 numflush, LSN_FORMAT_ARGS(flushPtr),
@@ -895,16 +912,36 @@ SyncRepGetStandbyPriority(void)
 	return (SyncRepConfig->syncrep_method == SYNC_REP_PRIORITY) ? priority : 1;
 }
 
+/*
+ * Return scratch space for recording the latches of the backends removed
+ * from the wait queues, so that they can be set after SyncRepLock has been
+ * released.  A backend waits in at most one queue, so MaxBackends entries
+ * are always enough.
+ */
+static Latch **
+SyncRepWakeupArray(void)
+{
+	static Latch **latches = NULL;
+
+	if (latches == NULL)
+		latches = MemoryContextAlloc(TopMemoryContext,
+									 MaxBackends * sizeof(Latch *));
+	return latches;
+}
+
 /*
  * Walk the specified queue from head.  Set the state of any backends that
- * need to be woken, remove them from the queue, and then wake them.
- * Pass all = true to wake whole queue; otherwise, just wake up to
- * the walsender's LSN.
+ * need to be woken and remove them from the queue, recording their latches
+ * in the caller-provided array.  Pass all = true to release the whole
+ * queue; otherwise, just release up to the walsender's LSN.
  *
- * The caller must hold SyncRepLock in exclusive mode.
+ * The caller must hold SyncRepLock in exclusive mode, and must set the
+ * recorded latches once the lock has been released: SetLatch can involve a
+ * system call per waiter, and doing that while holding the lock makes the
+ * lock itself the point of contention at high commit concurrency.
  */
 static int
-SyncRepWakeQueue(bool all, int mode)
+SyncRepWakeQueue(bool all, int mode, Latch **latches)
 {
 	volatile WalSndCtlData *walsndctl = WalSndCtl;
 	int			numprocs = 0;
@@ -943,9 +980,10 @@ SyncRepWakeQueue(bool all, int mode)
 		proc->syncRepState = SYNC_REP_WAIT_COMPLETE;
 
 		/*
-		 * Wake only when we have set state and removed from queue.
+		 * Wake only when we have set state and removed from queue; the
+		 * caller does that after releasing SyncRepLock.
 		 */
-		SetLatch(&(proc->procLatch));
+		latches[numprocs] = &proc->procLatch;
 
 		numprocs++;
 	}
@@ -968,6 +1006,10 @@ SyncRepUpdateSyncStandbysDefined(void)
 	if (sync_standbys_defined !=
 		((WalSndCtl->sync_standbys_status & SYNC_STANDBY_DEFINED) != 0))
 	{
+		Latch	  **latches = SyncRepWakeupArray();
+		int			numlatches = 0;
+		int			i;
+
 		LWLockAcquire(SyncRepLock, LW_EXCLUSIVE);
 
 		/*
@@ -977,10 +1019,9 @@ SyncRepUpdateSyncStandbysDefined(void)
 		 */
 		if (!sync_standbys_defined)
 		{
-			int			i;
-
 			for (i = 0; i < NUM_SYNC_REP_WAIT_MODE; i++)
-				SyncRepWakeQueue(true, i);
+				numlatches += SyncRepWakeQueue(true, i,
+											   latches + numlatches);
 		}
 
 		/*
@@ -994,6 +1035,9 @@ SyncRepUpdateSyncStandbysDefined(void)
 			(sync_standbys_defined ? SYNC_STANDBY_DEFINED : 0);
 
 		LWLockRelease(SyncRepLock);
+
+		for (i = 0; i < numlatches; i++)
+			SetLatch(latches[i]);
 	}
 	else if ((WalSndCtl->sync_standbys_status & SYNC_STANDBY_INIT) == 0)
 	{
@@ -1574,6 +1574,20 @@ WalSndWriteData(LogicalDecodingContext *ctx, XLogRecPtr lsn, TransactionId xid,
 
 	CHECK_FOR_INTERRUPTS();
 
+	/*
+	 * Don't knock on the socket for every message; narrow rows produce
+	 * messages much smaller than what a send() call is worth.  Let them
+	 * accumulate in the output buffer until enough has been gathered, and
+	 * rely on WalSndLoop to flush whatever remains once the current batch of
+	 * changes has been decoded.  Skip this shortcut when we are getting
+	 * close to the walsender timeout, so that the reply and keepalive
+	 * processing below still runs.
+	 */
+	if (pq_send_pending_data() < MAX_SEND_SIZE &&
+		now < TimestampTzPlusMilliseconds(last_reply_timestamp,
+										  wal_sender_timeout / 2))
+		return;
+
 	/* Try to flush pending output to the client */
 	if (pq_flush_if_writable() != 0)
 		WalSndShutdown();
@@ -3784,7 +3798,8 @@ WalSndWakeup(bool physical, bool logical)
 static void
 WalSndWait(uint32 socket_events, long timeout, uint32 wait_event)
 {
-	WaitEvent	event;
+	WaitEvent	events[FeBeWaitSetNEvents];
+	int			nevents;
 
 	ModifyWaitEvent(FeBeWaitSet, FeBeWaitSetSocketPos, socket_events, NULL);
 
@@ -3823,11 +3838,22 @@ WalSndWait(uint32 socket_events, long timeout, uint32 wait_event)
 	else if (MyWalSnd->kind == REPLICATION_KIND_LOGICAL)
 		ConditionVariablePrepareToSleep(&WalSndCtl->wal_replay_cv);
 
-	if (WaitEventSetWait(FeBeWaitSet, timeout, &event, 1, wait_event) == 1 &&
-		(event.events & WL_POSTMASTER_DEATH))
+	/*
+	 * Retrieve all ready events in one call: with a single-event buffer, a
+	 * set latch can shadow the other events (cf. pq_check_connection), so a
+	 * busy walsender might not notice postmaster death until the next round.
+	 * Our callers recheck socket and latch state themselves, so the events
+	 * need no individual handling here.
+	 */
+	nevents = WaitEventSetWait(FeBeWaitSet, timeout, events, lengthof(events),
+							   wait_event);
+	for (int i = 0; i < nevents; i++)
 	{
-		ConditionVariableCancelSleep();
-		proc_exit(1);
+		if (events[i].events & WL_POSTMASTER_DEATH)
+		{
+			ConditionVariableCancelSleep();
+			proc_exit(1);
+		}
 	}
 
 	ConditionVariableCancelSleep();
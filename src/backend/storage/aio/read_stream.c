@@ -20,9 +20,11 @@
  * The algorithm for controlling the look-ahead distance is based on recent
  * cache hit and miss history.  When no I/O is necessary, there is no benefit
  * in looking ahead more than one block.  This is the default initial
- * assumption, but when blocks needing I/O are streamed, the distance is
- * increased rapidly to try to benefit from I/O combining and concurrency.  It
- * is reduced gradually when cached blocks are streamed.
+ * assumption, but while the consumer stalls waiting for I/O, the distance is
+ * increased rapidly to try to benefit from I/O combining and concurrency;
+ * once started I/Os complete before their buffers are needed, the distance
+ * has caught up with the device's latency and is held steady.  It is reduced
+ * gradually when cached blocks are streamed.
  *
  * The main data structure is a circular queue of buffers of size
  * max_pinned_buffers plus some extra space for technical reasons, ready to be
@@ -99,6 +101,7 @@ struct ReadStream
 	int16		forwarded_buffers;
 	int16		pinned_buffers;
 	int16		distance;
+	int16		max_distance;	/* highest look-ahead distance reached */
 	int16		initialized_buffers;
 	int			read_buffers_flags;
 	bool		sync_mode;		/* using io_method=sync */
@@ -690,6 +693,7 @@ read_stream_begin_impl(int flags,
 		stream->distance = Min(max_pinned_buffers, stream->io_combine_limit);
 	else
 		stream->distance = 1;
+	stream->max_distance = stream->distance;
 
 	/*
 	 * Since we always access the same relation, we can initialize parts of
@@ -892,12 +896,22 @@ read_stream_next_buffer(ReadStream *stream, void **per_buffer_data)
 		stream->ios[stream->oldest_io_index].buffer_index == oldest_buffer_index)
 	{
 		int16		io_index = stream->oldest_io_index;
-		int32		distance;	/* wider temporary value, clamped below */
+		bool		stalled;
 
 		/* Sanity check that we still agree on the buffers. */
 		Assert(stream->ios[io_index].op.buffers ==
 			   &stream->buffers[oldest_buffer_index]);
 
+		/*
+		 * Will we actually have to wait, or had the I/O already completed by
+		 * the time we got here?  With io_method=sync the I/O is performed
+		 * inside WaitReadBuffers(), so there is no way to tell and we assume
+		 * a stall.
+		 */
+		stalled = stream->sync_mode ||
+			!pgaio_wref_valid(&stream->ios[io_index].op.io_wref) ||
+			!pgaio_wref_check_done(&stream->ios[io_index].op.io_wref);
+
 		WaitReadBuffers(&stream->ios[io_index].op);
 
 		Assert(stream->ios_in_progress > 0);
@@ -905,10 +919,23 @@ read_stream_next_buffer(ReadStream *stream, void **per_buffer_data)
 		if (++stream->oldest_io_index == stream->max_ios)
 			stream->oldest_io_index = 0;
 
-		/* Look-ahead distance ramps up rapidly after we do I/O. */
-		distance = stream->distance * 2;
-		distance = Min(distance, stream->max_pinned_buffers);
-		stream->distance = distance;
+		/*
+		 * The look-ahead distance ramps up rapidly while the consumer is
+		 * stalling on I/O, since the current distance evidently doesn't
+		 * start reads far enough ahead to cover the device's latency.  Once
+		 * I/Os reliably complete before we need their buffers, the distance
+		 * is sufficient and is held where it is, rather than growing to the
+		 * pin limit for no benefit.
+		 */
+		if (stalled)
+		{
+			int32		distance;	/* wider temporary value, clamped below */
+
+			distance = stream->distance * 2;
+			distance = Min(distance, stream->max_pinned_buffers);
+			stream->distance = distance;
+			stream->max_distance = Max(stream->max_distance, stream->distance);
+		}
 
 		/*
 		 * If we've reached the first block of a sequential region we're
@@ -1000,6 +1027,17 @@ read_stream_next_block(ReadStream *stream, BufferAccessStrategy *strategy)
 	return read_stream_get_block(stream, NULL);
 }
 
+/*
+ * Return the highest look-ahead distance the stream has reached so far.  This
+ * reflects the effective I/O depth that was achieved, which is useful for
+ * instrumentation.  The high-water mark survives read_stream_reset().
+ */
+int
+read_stream_max_distance(ReadStream *stream)
+{
+	return stream->max_distance;
+}
+
 /*
  * Reset a read stream by releasing any queued up buffers, allowing the stream
  * to be used again for different blocks.  This can be used to clear an
@@ -62,6 +62,7 @@
 #include "storage/smgr.h"
 #include "storage/standby.h"
 #include "utils/memdebug.h"
+#include "utils/memutils.h"
 #include "utils/ps_status.h"
 #include "utils/rel.h"
 #include "utils/resowner.h"
@@ -220,6 +221,48 @@ static PrivateRefCountEntry *ReservedRefCountEntry = NULL;
 
 static uint32 MaxProportionalPins;
 
+/*
+ * Backend-local cache of recent buffer mapping lookups.
+ *
+ * Translating a buffer tag into a buffer ID normally means hashing the tag
+ * and searching the shared buffer mapping table while holding one of its
+ * partition locks.  On read-mostly workloads with many cores, the partition
+ * locks are a significant source of shared cache line traffic even though
+ * they are only taken in shared mode.  This small direct-mapped cache
+ * remembers the results of this backend's recent lookups, so that repeated
+ * accesses to the same blocks can pin their buffers without touching the
+ * mapping table at all.
+ *
+ * Entries are mere hints: a cached buffer may have been evicted and recycled
+ * for another page at any time.  BufferAlloc() therefore revalidates the tag
+ * while holding the buffer header spinlock before pinning, following the
+ * same protocol as ReadRecentBuffer(), and discards entries that turn out to
+ * be stale.  The shared mapping table remains the sole authority.
+ */
+typedef struct BufMappingCacheEntry
+{
+	BufferTag	tag;
+	Buffer		buffer;
+} BufMappingCacheEntry;
+
+#define BUF_MAPPING_CACHE_SIZE	64	/* must be a power of two */
+
+static BufMappingCacheEntry BufMappingCache[BUF_MAPPING_CACHE_SIZE];
+
+/*
+ * Find the cache slot for a given tag.  The hash only needs to spread
+ * consecutive blocks of the relations a backend is actively working with, so
+ * something very cheap will do.
+ */
+static inline BufMappingCacheEntry *
+BufMappingCacheSlot(const BufferTag *tag)
+{
+	uint32		hash;
+
+	hash = tag->blockNum ^ (uint32) tag->relNumber ^ (uint32) tag->forkNum;
+	return &BufMappingCache[hash & (BUF_MAPPING_CACHE_SIZE - 1)];
+}
+
 static void ReservePrivateRefCountEntry(void);
 static PrivateRefCountEntry *NewPrivateRefCountEntry(Buffer buffer);
 static PrivateRefCountEntry *GetPrivateRefCountEntry(Buffer buffer, bool do_move);
@@ -518,6 +561,8 @@ static void UnpinBuffer(BufferDesc *buf);
 static void UnpinBufferNoOwner(BufferDesc *buf);
 static void BufferSync(int flags);
 static uint32 WaitBufHdrUnlocked(BufferDesc *buf);
+static int	SyncBufferBatch(const CkptSortItem *items, int nitems,
+							WritebackContext *wb_context, int *num_written);
 static int	SyncOneBuffer(int buf_id, bool skip_recently_used,
 						  WritebackContext *wb_context);
 static void WaitIO(BufferDesc *buf);
@@ -2010,6 +2055,7 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 	BufferTag	newTag;			/* identity of requested block */
 	uint32		newHash;		/* hash value for newTag */
 	LWLock	   *newPartitionLock;	/* buffer partition lock for it */
+	BufMappingCacheEntry *cache_ent;
 	int			existing_buf_id;
 	Buffer		victim_buffer;
 	BufferDesc *victim_buf_hdr;
@@ -2022,6 +2068,78 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 	/* create a tag so we can lookup the buffer */
 	InitBufferTag(&newTag, &smgr->smgr_rlocator.locator, forkNum, blockNum);
 
+	/*
+	 * Before consulting the shared mapping table, check whether a recent
+	 * lookup of this tag is still cached locally.  If the cached buffer still
+	 * carries the tag we want, we can pin it without taking the mapping
+	 * partition lock at all.  As in ReadRecentBuffer(), the tag must be
+	 * checked before pinning, while holding the buffer header spinlock;
+	 * pinning first and asking questions later could confuse code paths like
+	 * InvalidateBuffer().
+	 */
+	cache_ent = BufMappingCacheSlot(&newTag);
+	if (BufferTagsEqual(&cache_ent->tag, &newTag))
+	{
+		BufferDesc *buf = GetBufferDescriptor(cache_ent->buffer - 1);
+		uint32		buf_state;
+
+		if (GetPrivateRefCount(cache_ent->buffer) > 0)
+		{
+			/*
+			 * We already have the buffer pinned, so its tag cannot change
+			 * under us and it is safe to check without locking.
+			 */
+			buf_state = pg_atomic_read_u32(&buf->state);
+			if ((buf_state & BM_VALID) && BufferTagsEqual(&buf->tag, &newTag))
+			{
+				PinBuffer(buf, strategy);
+
+				*foundPtr = true;
+				return buf;
+			}
+		}
+		else
+		{
+			buf_state = LockBufHdr(buf);
+			if ((buf_state & BM_VALID) && BufferTagsEqual(&buf->tag, &newTag))
+			{
+				/*
+				 * Got it.  Pin the buffer, advancing its usage count by
+				 * PinBuffer()'s rules; this is like PinBuffer_Locked(),
+				 * except that function never touches the usage count.
+				 */
+				Buffer		b = BufferDescriptorGetBuffer(buf);
+				PrivateRefCountEntry *ref;
+
+				VALGRIND_MAKE_MEM_DEFINED(BufHdrGetBlock(buf), BLCKSZ);
+
+				buf_state += BUF_REFCOUNT_ONE;
+				if (strategy == NULL)
+				{
+					if (BUF_STATE_GET_USAGECOUNT(buf_state) < BM_MAX_USAGE_COUNT)
+						buf_state += BUF_USAGECOUNT_ONE;
+				}
+				else
+				{
+					if (BUF_STATE_GET_USAGECOUNT(buf_state) == 0)
+						buf_state += BUF_USAGECOUNT_ONE;
+				}
+				UnlockBufHdr(buf, buf_state);
+
+				ref = NewPrivateRefCountEntry(b);
+				ref->refcount++;
+				ResourceOwnerRememberBuffer(CurrentResourceOwner, b);
+
+				*foundPtr = true;
+				return buf;
+			}
+			UnlockBufHdr(buf, buf_state);
+		}
+
+		/* The cached translation is stale; forget it. */
+		ClearBufferTag(&cache_ent->tag);
+	}
+
 	/* determine its hash code and partition lock ID */
 	newHash = BufTableHashCode(&newTag);
 	newPartitionLock = BufMappingPartitionLock(newHash);
@@ -2046,6 +2164,10 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 		/* Can release the mapping lock as soon as we've pinned it */
 		LWLockRelease(newPartitionLock);
 
+		/* Remember the translation, in hopes of skipping the lock next time */
+		cache_ent->tag = newTag;
+		cache_ent->buffer = BufferDescriptorGetBuffer(buf);
+
 		*foundPtr = true;
 
 		if (!valid)
@@ -2114,6 +2236,10 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 		/* Can release the mapping lock as soon as we've pinned it */
 		LWLockRelease(newPartitionLock);
 
+		/* Remember the translation, in hopes of skipping the lock next time */
+		cache_ent->tag = newTag;
+		cache_ent->buffer = BufferDescriptorGetBuffer(existing_buf_hdr);
+
 		*foundPtr = true;
 
 		if (!valid)
@@ -2145,8 +2271,15 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 	 * checkpoint.  Unlogged buffers only need to be written at shutdown
 	 * checkpoints, except for their "init" forks, which need to be treated
 	 * just like permanent relations.
-	 */
-	victim_buf_state |= BM_TAG_VALID | BUF_USAGECOUNT_ONE;
+	 *
+	 * Pages faulted in through a buffer access strategy start out with a zero
+	 * usage_count, so that a large scan cannot displace the established
+	 * working set: the clock sweep can reclaim such pages as soon as they are
+	 * unpinned, unless some other access promotes them first (see PinBuffer).
+	 */
+	victim_buf_state |= BM_TAG_VALID;
+	if (strategy == NULL)
+		victim_buf_state += BUF_USAGECOUNT_ONE;
 	if (relpersistence == RELPERSISTENCE_PERMANENT || forkNum == INIT_FORKNUM)
 		victim_buf_state |= BM_PERMANENT;
 
@@ -2154,6 +2287,10 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 
 	LWLockRelease(newPartitionLock);
 
+	/* Remember the translation, in hopes of skipping the lock next time */
+	cache_ent->tag = newTag;
+	cache_ent->buffer = victim_buffer;
+
 	/*
 	 * Buffer contents are currently invalid.
 	 */
@@ -2808,7 +2945,10 @@ ExtendBufferedRelShared(BufferManagerRelation bmr,
 
 			victim_buf_hdr->tag = tag;
 
-			buf_state |= BM_TAG_VALID | BUF_USAGECOUNT_ONE;
+			/* As in BufferAlloc(), strategy pages start out unprotected. */
+			buf_state |= BM_TAG_VALID;
+			if (strategy == NULL)
+				buf_state += BUF_USAGECOUNT_ONE;
 			if (bmr.relpersistence == RELPERSISTENCE_PERMANENT || fork == INIT_FORKNUM)
 				buf_state |= BM_PERMANENT;
 
@@ -3048,10 +3188,12 @@ ReleaseAndReadBuffer(Buffer buffer,
  * For the default access strategy, the buffer's usage_count is incremented
  * when we first pin it; for other strategies we just make sure the usage_count
  * isn't zero.  (The idea of the latter is that we don't want synchronized
- * heap scans to inflate the count, but we need it to not be zero to discourage
- * other backends from stealing buffers from our ring.  As long as we cycle
- * through the ring faster than the global clock-sweep cycles, buffers in
- * our ring won't be chosen as victims for replacement by other backends.)
+ * heap scans to inflate the count; raising it to one discourages other
+ * backends from stealing buffers from our ring while the scan is actively
+ * revisiting them.)  Together with the zero usage_count that strategy faults
+ * start out with (see BufferAlloc), this makes the replacement policy
+ * scan-resistant: a page brought in by a bulk scan only survives the next
+ * clock-sweep pass if something beyond that scan has referenced it.
  *
  * This should be applied only to shared buffers, never local ones.
  *
@@ -3388,6 +3530,23 @@ BufferSync(int flags)
 	{
 		BufferDesc *bufHdr = GetBufferDescriptor(buf_id);
 
+		/*
+		 * Skip clean buffers without taking the header spinlock.  A buffer
+		 * that is dirtied after this unlocked check was dirtied after the
+		 * checkpoint began and need not be written by it, just like one
+		 * dirtied after the locked check below; so this is merely an earlier
+		 * observation of the same race, and with a mostly-clean buffer pool
+		 * it avoids the bulk of the spinlock traffic of this scan.
+		 */
+		buf_state = pg_atomic_read_u32(&bufHdr->state);
+		if ((buf_state & mask) != mask)
+		{
+			/* Check for barrier events in case NBuffers is large. */
+			if (ProcSignalBarrierPending)
+				ProcessProcSignalBarrier();
+			continue;
+		}
+
 		/*
 		 * Header spinlock is enough to examine BM_DIRTY, see comment in
 		 * SyncOneBuffer.
@@ -3403,6 +3562,7 @@ BufferSync(int flags)
 			item = &CkptBufferIds[num_to_scan++];
 			item->buf_id = buf_id;
 			item->tsId = bufHdr->tag.spcOid;
+			item->dbOid = bufHdr->tag.dbOid;
 			item->relNumber = BufTagGetRelNumber(&bufHdr->tag);
 			item->forkNum = BufTagGetForkNum(&bufHdr->tag);
 			item->blockNum = bufHdr->tag.blockNum;
@@ -3529,6 +3689,7 @@ BufferSync(int flags)
 	while (!binaryheap_empty(ts_heap))
 	{
 		BufferDesc *bufHdr = NULL;
+		int			num_this_round;
 		CkptTsStatus *ts_stat = (CkptTsStatus *)
 			DatumGetPointer(binaryheap_first(ts_heap));
 
@@ -3551,23 +3712,77 @@ BufferSync(int flags)
 		 * write the buffer though we didn't need to.  It doesn't seem worth
 		 * guarding against this, though.
 		 */
+		num_this_round = 1;
+
 		if (pg_atomic_read_u32(&bufHdr->state) & BM_CHECKPOINT_NEEDED)
 		{
-			if (SyncOneBuffer(buf_id, false, &wb_context) & BUF_WRITTEN)
+			int			max_combine;
+			int			nbatch;
+			int			consumed = 0;
+
+			/*
+			 * Look ahead in this tablespace's (sorted) portion of the
+			 * to-be-written list for directly following blocks of the same
+			 * relation fork, so that a run of adjacent dirty blocks can be
+			 * submitted as a single vectored write.
+			 */
+			max_combine = Min(io_combine_limit,
+							  ts_stat->num_to_scan - ts_stat->num_scanned);
+			nbatch = 1;
+			while (nbatch < max_combine)
 			{
-				TRACE_POSTGRESQL_BUFFER_SYNC_WRITTEN(buf_id);
-				PendingCheckpointerStats.buffers_written++;
-				num_written++;
+				const CkptSortItem *cur = &CkptBufferIds[ts_stat->index + nbatch - 1];
+				const CkptSortItem *next = &CkptBufferIds[ts_stat->index + nbatch];
+
+				if (next->dbOid != cur->dbOid ||
+					next->relNumber != cur->relNumber ||
+					next->forkNum != cur->forkNum ||
+					next->blockNum != cur->blockNum + 1)
+					break;
+				if (!(pg_atomic_read_u32(&GetBufferDescriptor(next->buf_id)->state) &
+					  BM_CHECKPOINT_NEEDED))
+					break;
+				nbatch++;
+			}
+
+			if (nbatch > 1)
+			{
+				int			batch_written;
+
+				consumed = SyncBufferBatch(&CkptBufferIds[ts_stat->index],
+										   nbatch, &wb_context,
+										   &batch_written);
+				PendingCheckpointerStats.buffers_written += batch_written;
+				num_written += batch_written;
 			}
+
+			/*
+			 * If no batch was attempted, or its very first buffer could not
+			 * be handled without blocking, write that buffer the ordinary
+			 * way, which waits for any conflicting I/O.
+			 */
+			if (consumed == 0)
+			{
+				consumed = 1;
+				if (SyncOneBuffer(buf_id, false, &wb_context) & BUF_WRITTEN)
+				{
+					TRACE_POSTGRESQL_BUFFER_SYNC_WRITTEN(buf_id);
+					PendingCheckpointerStats.buffers_written++;
+					num_written++;
+				}
+			}
+
+			num_this_round = consumed;
 		}
 
 		/*
 		 * Measure progress independent of actually having to flush the buffer
 		 * - otherwise writing become unbalanced.
 		 */
-		ts_stat->progress += ts_stat->progress_slice;
-		ts_stat->num_scanned++;
-		ts_stat->index++;
+		num_processed += num_this_round - 1;
+		ts_stat->progress += ts_stat->progress_slice * num_this_round;
+		ts_stat->num_scanned += num_this_round;
+		ts_stat->index += num_this_round;
 
 		/* Have all the buffers from the tablespace been processed? */
 		if (ts_stat->num_scanned == ts_stat->num_to_scan)
@@ -3902,6 +4117,195 @@ BgBufferSync(WritebackContext *wb_context)
 	return (bufs_to_lap == 0 && recent_alloc == 0);
 }
 
+/*
+ * SyncBufferBatch -- write out a run of adjacent dirty buffers during a
+ *		checkpoint.
+ *
+ * items describes nitems entries of the checkpoint sort array whose block
+ * numbers are consecutive within a single relation fork.  We pin and
+ * share-lock as long a prefix of the run as can be prepared without
+ * blocking, and write it out with a single smgrwritev() call, mirroring
+ * what FlushBuffer() does for an individual buffer.  A buffer that has
+ * been evicted or cleaned in the meantime, or whose locks cannot be taken
+ * immediately, simply ends the run; the caller processes the remainder
+ * through the ordinary one-buffer path.
+ *
+ * Returns the number of items consumed.  A return value of zero means the
+ * run's first buffer needs the blocking treatment of SyncOneBuffer().  The
+ * number of buffers actually written is returned in *num_written.
+ */
+static int
+SyncBufferBatch(const CkptSortItem *items, int nitems,
+				WritebackContext *wb_context, int *num_written)
+{
+	static char *staging = NULL;
+	BufferDesc *bufs[MAX_IO_COMBINE_LIMIT];
+	const void *pages[MAX_IO_COMBINE_LIMIT];
+	BufferTag	first_tag;
+	XLogRecPtr	flush_lsn = InvalidXLogRecPtr;
+	ErrorContextCallback errcallback;
+	SMgrRelation reln;
+	instr_time	io_start;
+	int			n = 0;
+
+	Assert(nitems > 1 && nitems <= MAX_IO_COMBINE_LIMIT);
+
+	*num_written = 0;
+
+	/* only used once a first buffer has been locked in, keep compiler quiet */
+	ClearBufferTag(&first_tag);
+
+	for (int i = 0; i < nitems; i++)
+	{
+		BufferDesc *bufHdr = GetBufferDescriptor(items[i].buf_id);
+		uint32		buf_state;
+
+		/* Make sure we can handle the pin */
+		ReservePrivateRefCountEntry();
+		ResourceOwnerEnlarge(CurrentResourceOwner);
+
+		/*
+		 * The buffer must still hold the expected block and still require a
+		 * checkpoint write; it may have been evicted or written out by
+		 * someone else since the run was planned.  (BM_CHECKPOINT_NEEDED is
+		 * only ever set by us, and any eviction or write clears it, so
+		 * checking it also means the tag can only match the sort entry.)
+		 */
+		buf_state = LockBufHdr(bufHdr);
+		if (!(buf_state & BM_VALID) || !(buf_state & BM_DIRTY) ||
+			!(buf_state & BM_CHECKPOINT_NEEDED) ||
+			bufHdr->tag.blockNum != items[i].blockNum ||
+			bufHdr->tag.dbOid != items[i].dbOid ||
+			BufTagGetRelNumber(&bufHdr->tag) != items[i].relNumber ||
+			BufTagGetForkNum(&bufHdr->tag) != items[i].forkNum)
+		{
+			UnlockBufHdr(bufHdr, buf_state);
+			break;
+		}
+
+		PinBuffer_Locked(bufHdr);
+
+		/*
+		 * Take the locks FlushBuffer() relies on, but without blocking: the
+		 * write combining is purely opportunistic, and a buffer we'd have to
+		 * wait for can be retried by the caller at its leisure.
+		 */
+		if (!LWLockConditionalAcquire(BufferDescriptorGetContentLock(bufHdr),
+									  LW_SHARED))
+		{
+			UnpinBuffer(bufHdr);
+			break;
+		}
+		if (!StartBufferIO(bufHdr, false, true))
+		{
+			LWLockRelease(BufferDescriptorGetContentLock(bufHdr));
+			UnpinBuffer(bufHdr);
+			break;
+		}
+
+		if (n == 0)
+			first_tag = bufHdr->tag;
+		bufs[n++] = bufHdr;
+	}
+
+	if (n == 0)
+		return 0;
+
+	/* Setup error traceback support for ereport() */
+	errcallback.callback = shared_buffer_write_error_callback;
+	errcallback.arg = bufs[0];
+	errcallback.previous = error_context_stack;
+	error_context_stack = &errcallback;
+
+	reln = smgropen(BufTagGetRelFileLocator(&first_tag), INVALID_PROC_NUMBER);
+
+	/*
+	 * As in FlushBuffer(), collect the buffer LSNs under the header locks
+	 * and force XLOG out far enough to cover all of them before writing.
+	 */
+	for (int i = 0; i < n; i++)
+	{
+		BufferDesc *bufHdr = bufs[i];
+		XLogRecPtr	recptr;
+		uint32		buf_state;
+
+		buf_state = LockBufHdr(bufHdr);
+		recptr = BufferGetLSN(bufHdr);
+		buf_state &= ~BM_JUST_DIRTIED;
+		UnlockBufHdr(bufHdr, buf_state);
+
+		if ((buf_state & BM_PERMANENT) && recptr > flush_lsn)
+			flush_lsn = recptr;
+	}
+	if (!XLogRecPtrIsInvalid(flush_lsn))
+		XLogFlush(flush_lsn);
+
+	/*
+	 * If checksums are in use, the pages must be copied out of shared
+	 * buffers before checksumming, since concurrent hint bit updates are
+	 * possible under only a share lock; see PageSetChecksumCopy().  One
+	 * staging area is kept for the life of the checkpointer.
+	 */
+	if (DataChecksumsEnabled())
+	{
+		if (staging == NULL)
+			staging = MemoryContextAllocAligned(TopMemoryContext,
+												MAX_IO_COMBINE_LIMIT * (Size) BLCKSZ,
+												PG_IO_ALIGN_SIZE, 0);
+		for (int i = 0; i < n; i++)
+		{
+			char	   *copy = staging + i * (Size) BLCKSZ;
+
+			memcpy(copy, BufHdrGetBlock(bufs[i]), BLCKSZ);
+			PageSetChecksumInplace((Page) copy, bufs[i]->tag.blockNum);
+			pages[i] = copy;
+		}
+	}
+	else
+	{
+		for (int i = 0; i < n; i++)
+			pages[i] = BufHdrGetBlock(bufs[i]);
+	}
+
+	io_start = pgstat_prepare_io_time(track_io_timing);
+
+	smgrwritev(reln,
+			   BufTagGetForkNum(&first_tag),
+			   first_tag.blockNum,
+			   pages, n,
+			   false);
+
+	pgstat_count_io_op_time(IOOBJECT_RELATION, IOCONTEXT_NORMAL,
+							IOOP_WRITE, io_start, 1, (uint64) n * BLCKSZ);
+
+	pgBufferUsage.shared_blks_written += n;
+
+	for (int i = 0; i < n; i++)
+	{
+		BufferDesc *bufHdr = bufs[i];
+		BufferTag	tag;
+
+		TerminateBufferIO(bufHdr, true, 0, true, false);
+
+		LWLockRelease(BufferDescriptorGetContentLock(bufHdr));
+
+		tag = bufHdr->tag;
+
+		TRACE_POSTGRESQL_BUFFER_SYNC_WRITTEN(bufHdr->buf_id);
+
+		UnpinBuffer(bufHdr);
+
+		ScheduleBufferTagForWriteback(wb_context, IOCONTEXT_NORMAL, &tag);
+	}
+
+	/* Pop the error context stack */
+	error_context_stack = errcallback.previous;
+
+	*num_written = n;
+
+	return n;
+}
+
 /*
  * SyncOneBuffer -- process a single buffer during syncing.
  *
@@ -6344,6 +6748,11 @@ ckpt_buforder_comparator(const CkptSortItem *a, const CkptSortItem *b)
 		return -1;
 	else if (a->tsId > b->tsId)
 		return 1;
+	/* compare database; relfilenumbers are only unique within a database */
+	if (a->dbOid < b->dbOid)
+		return -1;
+	else if (a->dbOid > b->dbOid)
+		return 1;
 	/* compare relation */
 	if (a->relNumber < b->relNumber)
 		return -1;
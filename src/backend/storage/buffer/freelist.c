@@ -757,11 +757,10 @@ GetBufferFromRing(BufferAccessStrategy strategy, uint32 *buf_state)
 	/*
 	 * If the buffer is pinned we cannot use it under any circumstances.
 	 *
-	 * If usage_count is 0 or 1 then the buffer is fair game (we expect 1,
-	 * since our own previous usage of the ring element would have left it
-	 * there, but it might've been decremented by clock sweep since then). A
-	 * higher usage_count indicates someone else has touched the buffer, so we
-	 * shouldn't re-use it.
+	 * If usage_count is 0 or 1 then the buffer is fair game (we expect 0,
+	 * since strategy faults start out that way, but our own re-use of the
+	 * ring element may have raised it to 1).  A higher usage_count indicates
+	 * someone else has touched the buffer, so we shouldn't re-use it.
 	 */
 	buf = GetBufferDescriptor(bufnum - 1);
 	local_buf_state = LockBufHdr(buf);
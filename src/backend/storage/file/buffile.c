@@ -856,6 +856,37 @@ BufFileSeekBlock(BufFile *file, int64 blknum)
 					   SEEK_SET);
 }
 
+/*
+ * BufFilePrefetchBlocks --- hint that blocks will be read soon
+ *
+ * Initiates an asynchronous read of nblocks BLCKSZ-sized blocks starting at
+ * blknum, so the kernel can have the data ready by the time it is actually
+ * read.  This is only a hint: requests beyond the current end of a component
+ * file, or on platforms without prefetch support, are silently ignored.  The
+ * logical read/write position is not changed.
+ */
+void
+BufFilePrefetchBlocks(BufFile *file, int64 blknum, int nblocks)
+{
+#ifdef USE_PREFETCH
+	while (nblocks > 0)
+	{
+		int			fileno = (int) (blknum / BUFFILE_SEG_SIZE);
+		off_t		offset = (off_t) (blknum % BUFFILE_SEG_SIZE) * BLCKSZ;
+		int			nthis = Min(nblocks,
+								(int) (BUFFILE_SEG_SIZE - blknum % BUFFILE_SEG_SIZE));
+
+		if (fileno >= file->numFiles)
+			break;
+		(void) FilePrefetch(file->files[fileno], offset,
+							(off_t) nthis * BLCKSZ,
+							WAIT_EVENT_BUFFILE_PREFETCH);
+		blknum += nthis;
+		nblocks -= nthis;
+	}
+#endif
+}
+
 /*
  * Returns the amount of data in the given BufFile, in bytes.
  *
@@ -113,6 +113,20 @@ static uint8 fsm_vacuum_page(Relation rel, FSMAddress addr,
 							 BlockNumber start, BlockNumber end,
 							 bool *eof_p);
 static bool fsm_does_block_exist(Relation rel, BlockNumber blknumber);
+static void fsm_cache_remember(SMgrRelation smgr, BlockNumber blkno, uint8 cat);
+
+/*
+ * Each backend remembers the result of its most recent successful FSM search
+ * for a relation (in the relation's SMgrRelation), and hands out the same
+ * target block for up to FSM_CACHE_MAX_USES requests needing no more space
+ * than that search asked for, instead of walking the FSM tree in shared
+ * buffers for every request.  The FSM is only ever a hint -- callers must
+ * check the actual free space on the returned page -- so serving slightly
+ * stale answers is safe.  The cached block is dropped as soon as less space
+ * is recorded for it, and smgr cache flush events (which cover truncation)
+ * clear it as well.
+ */
+#define FSM_CACHE_MAX_USES	16
 
 
 /******** Public API ********/
@@ -137,8 +151,26 @@ BlockNumber
 GetPageWithFreeSpace(Relation rel, Size spaceNeeded)
 {
 	uint8		min_cat = fsm_space_needed_to_cat(spaceNeeded);
+	SMgrRelation smgr = RelationGetSmgr(rel);
+	BlockNumber blkno;
+
+	/*
+	 * If a recent search found a page with at least this much free space,
+	 * hand out the same page again rather than repeating the search.  The
+	 * caller has to verify the actual free space on the page anyway.
+	 */
+	if (smgr->smgr_fsm_targblock != InvalidBlockNumber &&
+		min_cat <= smgr->smgr_fsm_cat &&
+		smgr->smgr_fsm_uses > 0)
+	{
+		smgr->smgr_fsm_uses--;
+		return smgr->smgr_fsm_targblock;
+	}
+
+	blkno = fsm_search(rel, min_cat);
+	fsm_cache_remember(smgr, blkno, min_cat);
 
-	return fsm_search(rel, min_cat);
+	return blkno;
 }
 
 /*
@@ -156,9 +188,18 @@ RecordAndGetPageWithFreeSpace(Relation rel, BlockNumber oldPage,
 {
 	int			old_cat = fsm_space_avail_to_cat(oldSpaceAvail);
 	int			search_cat = fsm_space_needed_to_cat(spaceNeeded);
+	SMgrRelation smgr = RelationGetSmgr(rel);
 	FSMAddress	addr;
 	uint16		slot;
 	int			search_slot;
+	BlockNumber blkno;
+
+	/*
+	 * The old page evidently didn't have enough room; if it's the cached
+	 * target block, stop handing it out.
+	 */
+	if (smgr->smgr_fsm_targblock == oldPage)
+		smgr->smgr_fsm_targblock = InvalidBlockNumber;
 
 	/* Get the location of the FSM byte representing the heap block */
 	addr = fsm_get_location(oldPage, &slot);
@@ -178,9 +219,16 @@ RecordAndGetPageWithFreeSpace(Relation rel, BlockNumber oldPage,
 		 * update the FSM in that case, just fall back to the other case
 		 */
 		if (fsm_does_block_exist(rel, blknum))
+		{
+			fsm_cache_remember(smgr, blknum, search_cat);
 			return blknum;
+		}
 	}
-	return fsm_search(rel, search_cat);
+
+	blkno = fsm_search(rel, search_cat);
+	fsm_cache_remember(smgr, blkno, search_cat);
+
+	return blkno;
 }
 
 /*
@@ -194,15 +242,35 @@ void
 RecordPageWithFreeSpace(Relation rel, BlockNumber heapBlk, Size spaceAvail)
 {
 	int			new_cat = fsm_space_avail_to_cat(spaceAvail);
+	SMgrRelation smgr = RelationGetSmgr(rel);
 	FSMAddress	addr;
 	uint16		slot;
 
+	/* Don't keep handing out the cached target block if its space shrank. */
+	if (smgr->smgr_fsm_targblock == heapBlk &&
+		new_cat < smgr->smgr_fsm_cat)
+		smgr->smgr_fsm_targblock = InvalidBlockNumber;
+
 	/* Get the location of the FSM byte representing the heap block */
 	addr = fsm_get_location(heapBlk, &slot);
 
 	fsm_set_and_search(rel, addr, slot, new_cat, 0);
 }
 
+/*
+ * fsm_cache_remember - remember a search result in the backend-local cache.
+ *
+ * Remembering an InvalidBlockNumber result effectively disables the cache
+ * until the next successful search.
+ */
+static void
+fsm_cache_remember(SMgrRelation smgr, BlockNumber blkno, uint8 cat)
+{
+	smgr->smgr_fsm_targblock = blkno;
+	smgr->smgr_fsm_cat = cat;
+	smgr->smgr_fsm_uses = FSM_CACHE_MAX_USES;
+}
+
 /*
  * XLogRecordPageWithFreeSpace - like RecordPageWithFreeSpace, for use in
  *		WAL replay
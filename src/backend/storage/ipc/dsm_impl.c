@@ -66,6 +66,7 @@
 #include "postmaster/postmaster.h"
 #include "storage/dsm_impl.h"
 #include "storage/fd.h"
+#include "storage/pg_shmem.h"
 #include "utils/guc.h"
 #include "utils/memutils.h"
 
@@ -332,6 +333,19 @@ dsm_impl_posix(dsm_op op, dsm_handle handle, Size request_size,
 						name)));
 		return false;
 	}
+	/*
+	 * Ask for transparent huge pages when the huge_pages setting permits.
+	 * shm_open objects cannot be mapped with MAP_HUGETLB, but Linux can back
+	 * shmem mappings with transparent huge pages when so advised, subject to
+	 * the kernel's shmem_enabled setting.  This is strictly best-effort:
+	 * where the advice is unsupported or declined we simply keep normal
+	 * pages, so any failure is ignored.
+	 */
+#ifdef MADV_HUGEPAGE
+	if (huge_pages != HUGE_PAGES_OFF)
+		(void) madvise(address, request_size, MADV_HUGEPAGE);
+#endif
+
 	*mapped_address = address;
 	*mapped_size = request_size;
 	close(fd);
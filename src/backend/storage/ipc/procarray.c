@@ -767,6 +767,7 @@ ProcArrayEndTransactionInternal(PGPROC *proc, TransactionId latestXid)
 		ProcGlobal->subxidStates[pgxactoff].overflowed = false;
 		proc->subxidStatus.count = 0;
 		proc->subxidStatus.overflowed = false;
+		SubxidFilterReset(&proc->subxidsFilter);
 	}
 
 	/* Also advance global latestCompletedXid while holding the lock */
@@ -954,6 +955,7 @@ ProcArrayClearTransaction(PGPROC *proc)
 		ProcGlobal->subxidStates[pgxactoff].overflowed = false;
 		proc->subxidStatus.count = 0;
 		proc->subxidStatus.overflowed = false;
+		SubxidFilterReset(&proc->subxidsFilter);
 	}
 
 	LWLockRelease(ProcArrayLock);
@@ -2310,6 +2312,29 @@ GetSnapshotData(Snapshot snapshot)
 				}
 			}
 		}
+
+		/*
+		 * If any subxid cache overflowed, XidInMVCCSnapshot() will have to
+		 * map XIDs to their top-level transaction through pg_subtrans, since
+		 * subxip is incomplete.  Collect the union of the subxid filters of
+		 * all transactions with subxacts, so most XIDs can skip that lookup.
+		 * This must happen while we still hold ProcArrayLock, because the
+		 * filters are reset when their transactions end.
+		 */
+		if (suboverflowed)
+		{
+			SubxidFilterReset(&snapshot->subxfilter);
+			for (int pgxactoff = 0; pgxactoff < numProcs; pgxactoff++)
+			{
+				if (subxidStates[pgxactoff].count > 0 ||
+					subxidStates[pgxactoff].overflowed)
+					SubxidFilterUnion(&snapshot->subxfilter,
+									  &allProcs[pgprocnos[pgxactoff]].subxidsFilter);
+			}
+			snapshot->subxfilter_valid = true;
+		}
+		else
+			snapshot->subxfilter_valid = false;
 	}
 	else
 	{
@@ -2347,6 +2372,9 @@ GetSnapshotData(Snapshot snapshot)
 
 		if (TransactionIdPrecedesOrEquals(xmin, procArray->lastOverflowedXid))
 			suboverflowed = true;
+
+		/* no per-proc subxid filters to consult during recovery */
+		snapshot->subxfilter_valid = false;
 	}
 
 
@@ -271,6 +271,7 @@ smgropen(RelFileLocator rlocator, ProcNumber backend)
 	{
 		/* hash_search already filled in the lookup key */
 		reln->smgr_targblock = InvalidBlockNumber;
+		reln->smgr_fsm_targblock = InvalidBlockNumber;
 		for (int i = 0; i <= MAX_FORKNUM; ++i)
 			reln->smgr_cached_nblocks[i] = InvalidBlockNumber;
 		reln->smgr_which = 0;	/* we only have md.c at present */
@@ -357,6 +358,7 @@ smgrrelease(SMgrRelation reln)
 		reln->smgr_cached_nblocks[forknum] = InvalidBlockNumber;
 	}
 	reln->smgr_targblock = InvalidBlockNumber;
+	reln->smgr_fsm_targblock = InvalidBlockNumber;
 
 	RESUME_INTERRUPTS();
 }
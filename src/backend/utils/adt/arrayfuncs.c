@@ -3801,6 +3801,29 @@ array_contains_nulls(ArrayType *array)
 }
 
 
+/*
+ * Is this equality function equivalent to bitwise equality of the stored
+ * element representation?  Only builtin functions we know to be simple
+ * integer comparisons of a by-value type qualify; in particular the float
+ * types do not, since their C-level == differs from bitwise equality for
+ * NaNs and signed zeroes.
+ */
+static bool
+array_eq_bitwise(Oid eqfuncoid)
+{
+	switch (eqfuncoid)
+	{
+		case F_BOOLEQ:
+		case F_CHAREQ:
+		case F_INT2EQ:
+		case F_INT4EQ:
+		case F_INT8EQ:
+		case F_OIDEQ:
+			return true;
+	}
+	return false;
+}
+
 /*
  * array_eq :
  *		  compares two arrays for equality
@@ -3870,54 +3893,79 @@ array_eq(PG_FUNCTION_ARGS)
 		typalign = typentry->typalign;
 
 		/*
-		 * apply the operator to each pair of array elements.
+		 * For fixed-width element types whose equality operator is plain
+		 * bitwise equality of the stored representation, null-free flat
+		 * arrays of equal dimensions can be compared with one memcmp of
+		 * their data areas: such elements are stored packed, with no padding
+		 * between them.  Note the float types do not qualify (NaN handling),
+		 * nor does anything collation- or normalization-sensitive.
 		 */
-		InitFunctionCallInfoData(*locfcinfo, &typentry->eq_opr_finfo, 2,
-								 collation, NULL, NULL);
-
-		/* Loop over source data */
-		nitems = ArrayGetNItems(ndims1, dims1);
-		array_iter_setup(&it1, array1);
-		array_iter_setup(&it2, array2);
-
-		for (i = 0; i < nitems; i++)
+		if (typbyval &&
+			array_eq_bitwise(typentry->eq_opr_finfo.fn_oid) &&
+			!VARATT_IS_EXPANDED_HEADER(array1) &&
+			!VARATT_IS_EXPANDED_HEADER(array2) &&
+			!AARR_HASNULL(array1) &&
+			!AARR_HASNULL(array2))
+		{
+			nitems = ArrayGetNItems(ndims1, dims1);
+			result = (memcmp(ARR_DATA_PTR((ArrayType *) array1),
+							 ARR_DATA_PTR((ArrayType *) array2),
+							 (size_t) nitems * typlen) == 0);
+		}
+		else
 		{
-			Datum		elt1;
-			Datum		elt2;
-			bool		isnull1;
-			bool		isnull2;
-			bool		oprresult;
-
-			/* Get elements, checking for NULL */
-			elt1 = array_iter_next(&it1, &isnull1, i,
-								   typlen, typbyval, typalign);
-			elt2 = array_iter_next(&it2, &isnull2, i,
-								   typlen, typbyval, typalign);
-
 			/*
-			 * We consider two NULLs equal; NULL and not-NULL are unequal.
+			 * apply the operator to each pair of array elements.
 			 */
-			if (isnull1 && isnull2)
-				continue;
-			if (isnull1 || isnull2)
-			{
-				result = false;
-				break;
-			}
+			InitFunctionCallInfoData(*locfcinfo, &typentry->eq_opr_finfo, 2,
+									 collation, NULL, NULL);
 
-			/*
-			 * Apply the operator to the element pair; treat NULL as false
-			 */
-			locfcinfo->args[0].value = elt1;
-			locfcinfo->args[0].isnull = false;
-			locfcinfo->args[1].value = elt2;
-			locfcinfo->args[1].isnull = false;
-			locfcinfo->isnull = false;
-			oprresult = DatumGetBool(FunctionCallInvoke(locfcinfo));
-			if (locfcinfo->isnull || !oprresult)
+			/* Loop over source data */
+			nitems = ArrayGetNItems(ndims1, dims1);
+			array_iter_setup(&it1, array1);
+			array_iter_setup(&it2, array2);
+
+			for (i = 0; i < nitems; i++)
 			{
-				result = false;
-				break;
+				Datum		elt1;
+				Datum		elt2;
+				bool		isnull1;
+				bool		isnull2;
+				bool		oprresult;
+
+				/* Get elements, checking for NULL */
+				elt1 = array_iter_next(&it1, &isnull1, i,
+									   typlen, typbyval, typalign);
+				elt2 = array_iter_next(&it2, &isnull2, i,
+									   typlen, typbyval, typalign);
+
+				/*
+				 * We consider two NULLs equal; NULL and not-NULL are
+				 * unequal.
+				 */
+				if (isnull1 && isnull2)
+					continue;
+				if (isnull1 || isnull2)
+				{
+					result = false;
+					break;
+				}
+
+				/*
+				 * Apply the operator to the element pair; treat NULL as
+				 * false
+				 */
+				locfcinfo->args[0].value = elt1;
+				locfcinfo->args[0].isnull = false;
+				locfcinfo->args[1].value = elt2;
+				locfcinfo->args[1].isnull = false;
+				locfcinfo->isnull = false;
+				oprresult = DatumGetBool(FunctionCallInvoke(locfcinfo));
+				if (locfcinfo->isnull || !oprresult)
+				{
+					result = false;
+					break;
+				}
 			}
 		}
 	}
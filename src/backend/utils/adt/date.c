@@ -128,15 +128,21 @@ date_in(PG_FUNCTION_ARGS)
 	char		workbuf[MAXDATELEN + 1];
 	DateTimeErrorExtra extra;
 
-	dterr = ParseDateTime(str, workbuf, sizeof(workbuf),
-						  field, ftype, MAXDATEFIELDS, &nf);
-	if (dterr == 0)
-		dterr = DecodeDateTime(field, ftype, nf,
-							   &dtype, tm, &fsec, &tzp, &extra);
-	if (dterr != 0)
+	/* Try the common case of strict ISO format before the full parser */
+	if (ParseISODateTimeFast(str, tm, &fsec))
+		dtype = DTK_DATE;
+	else
 	{
-		DateTimeParseError(dterr, &extra, str, "date", escontext);
-		PG_RETURN_NULL();
+		dterr = ParseDateTime(str, workbuf, sizeof(workbuf),
+							  field, ftype, MAXDATEFIELDS, &nf);
+		if (dterr == 0)
+			dterr = DecodeDateTime(field, ftype, nf,
+								   &dtype, tm, &fsec, &tzp, &extra);
+		if (dterr != 0)
+		{
+			DateTimeParseError(dterr, &extra, str, "date", escontext);
+			PG_RETURN_NULL();
+		}
 	}
 
 	switch (dtype)
@@ -738,6 +738,119 @@ ParseFractionalSecond(char *cp, fsec_t *fsec)
 }
 
 
+/*
+ * Decode exactly "ndigits" decimal digits starting at s into *val.
+ * Returns false if any of the characters is not a digit.
+ */
+static inline bool
+DecodeFixedDigits(const char *s, int ndigits, int *val)
+{
+	int			acc = 0;
+
+	for (int i = 0; i < ndigits; i++)
+	{
+		unsigned int d = (unsigned char) s[i] - '0';
+
+		if (d > 9)
+			return false;
+		acc = acc * 10 + (int) d;
+	}
+	*val = acc;
+	return true;
+}
+
+/* ParseISODateTimeFast()
+ *	Fast path for strictly formatted ISO-8601 date/timestamp input.
+ *
+ * Attempts to parse str as exactly
+ *		YYYY-MM-DD
+ * or
+ *		YYYY-MM-DD HH:MM:SS[.FFFFFF]
+ * (with 'T' also accepted as the date/time separator): fixed-width
+ * fields, AD years only, no timezone suffix, no leading or trailing
+ * junk.  On success, fills tm and fsec and returns true.  Any deviation
+ * returns false, in which case the caller must fall back to the general
+ * ParseDateTime/DecodeDateTime machinery; that keeps behavior and error
+ * reporting for everything else identical to the general path, at the
+ * cost of parsing such input twice.
+ *
+ * This format is unambiguous under every DateStyle setting (a leading
+ * four-digit field is always taken as the year), so the fast path need
+ * not consult DateOrder.  Bulk loads of ISO-format timestamps otherwise
+ * spend much of their input-function time in the general tokenizer.
+ */
+bool
+ParseISODateTimeFast(const char *str, struct pg_tm *tm, fsec_t *fsec)
+{
+	const char *s = str;
+	int			year,
+				month,
+				day,
+				hour,
+				min,
+				sec;
+	int32		frac = 0;
+
+	if (!DecodeFixedDigits(s, 4, &year) || s[4] != '-' ||
+		!DecodeFixedDigits(s + 5, 2, &month) || s[7] != '-' ||
+		!DecodeFixedDigits(s + 8, 2, &day))
+		return false;
+	s += 10;
+
+	if (*s == ' ' || *s == 'T')
+	{
+		s++;
+		if (!DecodeFixedDigits(s, 2, &hour) || s[2] != ':' ||
+			!DecodeFixedDigits(s + 3, 2, &min) || s[5] != ':' ||
+			!DecodeFixedDigits(s + 6, 2, &sec))
+			return false;
+		s += 8;
+		if (*s == '.')
+		{
+			int			ndigits = 0;
+
+			s++;
+			while (ndigits < MAX_TIMESTAMP_PRECISION &&
+				   isdigit((unsigned char) *s))
+			{
+				frac = frac * 10 + (*s - '0');
+				ndigits++;
+				s++;
+			}
+			/* no digits, or more precision than we store: fall back */
+			if (ndigits == 0 || isdigit((unsigned char) *s))
+				return false;
+			while (ndigits++ < MAX_TIMESTAMP_PRECISION)
+				frac *= 10;
+		}
+	}
+	else
+		hour = min = sec = 0;
+
+	if (*s != '\0')
+		return false;
+
+	/* Reject anything DecodeDate/DecodeTime would reject */
+	if (year == 0 ||
+		month < 1 || month > MONTHS_PER_YEAR ||
+		day < 1 || day > day_tab[isleap(year)][month - 1] ||
+		hour > 23 || min > 59 || sec > 59)
+		return false;
+
+	tm->tm_year = year;
+	tm->tm_mon = month;
+	tm->tm_mday = day;
+	tm->tm_hour = hour;
+	tm->tm_min = min;
+	tm->tm_sec = sec;
+	tm->tm_isdst = -1;
+	tm->tm_gmtoff = 0;
+	tm->tm_zone = NULL;
+	*fsec = frac;
+
+	return true;
+}
+
 /* ParseDateTime()
  *	Break string into tokens based on a date/time context.
  *	Returns 0 if successful, DTERR code if bogus input detected.
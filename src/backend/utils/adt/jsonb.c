@@ -228,8 +228,48 @@ JsonbTypeName(JsonbValue *val)
 Datum
 jsonb_typeof(PG_FUNCTION_ARGS)
 {
-	Jsonb	   *in = PG_GETARG_JSONB_P(0);
-	const char *result = JsonbContainerTypeName(&in->root);
+	Jsonb	   *in;
+	const char *result;
+
+	/*
+	 * The type of the root is determined by the container header word and,
+	 * for a root scalar, the type bits of its lone JEntry.  Detoast just
+	 * that prefix instead of a potentially large document; for compressed
+	 * or out-of-line values the slice path only decompresses or fetches
+	 * what is asked for.
+	 */
+	in = (Jsonb *) PG_DETOAST_DATUM_SLICE(PG_GETARG_DATUM(0), 0,
+										  offsetof(JsonbContainer, children) +
+										  sizeof(JEntry));
+
+	if (JB_ROOT_IS_SCALAR(in))
+	{
+		JEntry		entry = in->root.children[0];
+
+		/* on-disk scalars can only be of these four types */
+		if (JBE_ISNUMERIC(entry))
+			result = "number";
+		else if (JBE_ISSTRING(entry))
+			result = "string";
+		else if (JBE_ISBOOL(entry))
+			result = "boolean";
+		else if (JBE_ISNULL(entry))
+			result = "null";
+		else
+		{
+			elog(ERROR, "invalid jsonb scalar type");
+			result = "unknown";
+		}
+	}
+	else if (JB_ROOT_IS_ARRAY(in))
+		result = "array";
+	else if (JB_ROOT_IS_OBJECT(in))
+		result = "object";
+	else
+	{
+		elog(ERROR, "invalid jsonb container type: 0x%08x", in->root.header);
+		result = "unknown";
+	}
 
 	PG_RETURN_TEXT_P(cstring_to_text(result));
 }
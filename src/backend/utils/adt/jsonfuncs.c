@@ -1877,7 +1877,14 @@ json_array_length(PG_FUNCTION_ARGS)
 Datum
 jsonb_array_length(PG_FUNCTION_ARGS)
 {
-	Jsonb	   *jb = PG_GETARG_JSONB_P(0);
+	Jsonb	   *jb;
+
+	/*
+	 * The element count is stored in the root container's header word, so
+	 * there is no need to detoast anything beyond it.
+	 */
+	jb = (Jsonb *) PG_DETOAST_DATUM_SLICE(PG_GETARG_DATUM(0), 0,
+										  sizeof(uint32));
 
 	if (JB_ROOT_IS_SCALAR(jb))
 		ereport(ERROR,
@@ -172,6 +172,46 @@ MatchText(const char *t, int tlen, const char *p, int plen, pg_locale_t locale)
 			else
 				firstpat = GETCHAR(*p, locale);
 
+#ifdef USE_BYTE_SCAN
+
+			/*
+			 * In the builds where GETCHAR is the identity and text positions
+			 * of interest are byte positions, we can let memchr find the
+			 * candidate positions instead of inspecting every byte ourselves;
+			 * libc's memchr is typically vectorized.  This is safe for UTF8
+			 * as well: firstpat is the first byte of a pattern character, so
+			 * it is either an ASCII byte or a lead byte, and neither can
+			 * equal a continuation byte, meaning every hit lies on a
+			 * character boundary.  Nondeterministic collations must consider
+			 * every position, so they take the generic loop below.
+			 */
+			if (!locale || locale->deterministic)
+			{
+				while (tlen > 0)
+				{
+					const char *t1 = memchr(t, (unsigned char) firstpat, tlen);
+					int			matched;
+
+					if (t1 == NULL)
+						break;	/* no possible start position left */
+					tlen -= (t1 - t);
+					t = t1;
+
+					matched = MatchText(t, tlen, p, plen, locale);
+					if (matched != LIKE_FALSE)
+						return matched; /* TRUE or ABORT */
+
+					NextChar(t, tlen);
+				}
+
+				/*
+				 * End of text with no match, so no point in trying later
+				 * places to start matching this pattern.
+				 */
+				return LIKE_ABORT;
+			}
+#endif							/* USE_BYTE_SCAN */
+
 			while (tlen > 0)
 			{
 				if (GETCHAR(*t, locale) == firstpat || (locale && !locale->deterministic))
@@ -502,3 +542,7 @@ do_like_escape(text *pat, text *esc)
 #undef MATCH_LOWER
 
 #endif
+
+#ifdef USE_BYTE_SCAN
+#undef USE_BYTE_SCAN
+#endif
@@ -90,9 +90,16 @@ typedef struct regexp_matches_ctx
  * the cache as long as it's used at least once in every MAX_CACHED_RES uses.
  */
 
-/* this is the maximum number of cached regular expressions */
+/*
+ * This is the maximum number of cached regular expressions.  A compiled
+ * regexp costs far more to create than a cache slot costs to scan, so we
+ * size this generously; rule-engine-style workloads commonly cycle through
+ * a few hundred distinct patterns, and at 32 entries they thrashed the
+ * cache with recompilations.  The move-to-front discipline keeps the scan
+ * short for the patterns that are actually hot.
+ */
 #ifndef MAX_CACHED_RES
-#define MAX_CACHED_RES	32
+#define MAX_CACHED_RES	128
 #endif
 
 /* A parent memory context for regular expressions. */
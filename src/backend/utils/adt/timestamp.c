@@ -184,15 +184,21 @@ timestamp_in(PG_FUNCTION_ARGS)
 	char		workbuf[MAXDATELEN + MAXDATEFIELDS];
 	DateTimeErrorExtra extra;
 
-	dterr = ParseDateTime(str, workbuf, sizeof(workbuf),
-						  field, ftype, MAXDATEFIELDS, &nf);
-	if (dterr == 0)
-		dterr = DecodeDateTime(field, ftype, nf,
-							   &dtype, tm, &fsec, &tz, &extra);
-	if (dterr != 0)
+	/* Try the common case of strict ISO format before the full parser */
+	if (ParseISODateTimeFast(str, tm, &fsec))
+		dtype = DTK_DATE;
+	else
 	{
-		DateTimeParseError(dterr, &extra, str, "timestamp", escontext);
-		PG_RETURN_NULL();
+		dterr = ParseDateTime(str, workbuf, sizeof(workbuf),
+							  field, ftype, MAXDATEFIELDS, &nf);
+		if (dterr == 0)
+			dterr = DecodeDateTime(field, ftype, nf,
+								   &dtype, tm, &fsec, &tz, &extra);
+		if (dterr != 0)
+		{
+			DateTimeParseError(dterr, &extra, str, "timestamp", escontext);
+			PG_RETURN_NULL();
+		}
 	}
 
 	switch (dtype)
@@ -436,16 +442,25 @@ timestamptz_in(PG_FUNCTION_ARGS)
 	char		workbuf[MAXDATELEN + MAXDATEFIELDS];
 	DateTimeErrorExtra extra;
 
-	dterr = ParseDateTime(str, workbuf, sizeof(workbuf),
-						  field, ftype, MAXDATEFIELDS, &nf);
-	if (dterr == 0)
-		dterr = DecodeDateTime(field, ftype, nf,
-							   &dtype, tm, &fsec, &tz, &extra);
-	if (dterr != 0)
+	/* Try the common case of strict ISO format before the full parser */
+	if (ParseISODateTimeFast(str, tm, &fsec))
 	{
-		DateTimeParseError(dterr, &extra, str, "timestamp with time zone",
-						   escontext);
-		PG_RETURN_NULL();
+		dtype = DTK_DATE;
+		tz = DetermineTimeZoneOffset(tm, session_timezone);
+	}
+	else
+	{
+		dterr = ParseDateTime(str, workbuf, sizeof(workbuf),
+							  field, ftype, MAXDATEFIELDS, &nf);
+		if (dterr == 0)
+			dterr = DecodeDateTime(field, ftype, nf,
+								   &dtype, tm, &fsec, &tz, &extra);
+		if (dterr != 0)
+		{
+			DateTimeParseError(dterr, &extra, str, "timestamp with time zone",
+							   escontext);
+			PG_RETURN_NULL();
+		}
 	}
 
 	switch (dtype)
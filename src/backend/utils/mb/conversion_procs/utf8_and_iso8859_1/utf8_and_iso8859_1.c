@@ -14,6 +14,7 @@
 #include "postgres.h"
 #include "fmgr.h"
 #include "mb/pg_wchar.h"
+#include "utils/ascii.h"
 
 PG_MODULE_MAGIC_EXT(
 					.name = "utf8_and_iso8859_1",
@@ -59,7 +60,27 @@ iso8859_1_to_utf8(PG_FUNCTION_ARGS)
 			report_invalid_encoding(PG_LATIN1, (const char *) src, len);
 		}
 		if (!IS_HIGHBIT_SET(c))
+		{
+			/*
+			 * ASCII bytes other than NUL represent themselves in both
+			 * encodings, so while we're positioned on one, copy whole
+			 * vectors at a time for as long as they stay pure ASCII.
+			 */
+			while (len >= (int) sizeof(Vector8) &&
+				   is_valid_ascii(src, sizeof(Vector8)))
+			{
+				memcpy(dest, src, sizeof(Vector8));
+				src += sizeof(Vector8);
+				dest += sizeof(Vector8);
+				len -= sizeof(Vector8);
+			}
+			if (len <= 0)
+				break;
+			c = *src;
+			if (IS_HIGHBIT_SET(c) || c == 0)
+				continue;
 			*dest++ = c;
+		}
 		else
 		{
 			*dest++ = (c >> 6) | 0xc0;
@@ -98,6 +119,20 @@ utf8_to_iso8859_1(PG_FUNCTION_ARGS)
 		/* fast path for ASCII-subset characters */
 		if (!IS_HIGHBIT_SET(c))
 		{
+			/* copy whole vectors while the input stays pure ASCII */
+			while (len >= (int) sizeof(Vector8) &&
+				   is_valid_ascii(src, sizeof(Vector8)))
+			{
+				memcpy(dest, src, sizeof(Vector8));
+				src += sizeof(Vector8);
+				dest += sizeof(Vector8);
+				len -= sizeof(Vector8);
+			}
+			if (len <= 0)
+				break;
+			c = *src;
+			if (IS_HIGHBIT_SET(c) || c == 0)
+				continue;
 			*dest++ = c;
 			src++;
 			len--;
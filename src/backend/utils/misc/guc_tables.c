@@ -50,6 +50,8 @@
 #include "commands/vacuum.h"
 #include "common/file_utils.h"
 #include "common/scram-common.h"
+#include "executor/execParallel.h"
+#include "executor/nodeAgg.h"
 #include "jit/jit.h"
 #include "libpq/auth.h"
 #include "libpq/libpq.h"
@@ -100,6 +102,7 @@
 #include "utils/plancache.h"
 #include "utils/ps_status.h"
 #include "utils/rls.h"
+#include "utils/tuplestore.h"
 #include "utils/xml.h"
 
 #ifdef TRACE_SYNCSCAN
@@ -460,6 +463,9 @@ static const struct config_enum_entry default_toast_compression_options[] = {
 	{"pglz", TOAST_PGLZ_COMPRESSION, false},
 #ifdef  USE_LZ4
 	{"lz4", TOAST_LZ4_COMPRESSION, false},
+#endif
+#ifdef USE_ZSTD
+	{"zstd", TOAST_ZSTD_COMPRESSION, false},
 #endif
 	{NULL, 0, false}
 };
@@ -579,6 +585,7 @@ static int	ssl_renegotiation_limit;
 int			huge_pages = HUGE_PAGES_TRY;
 int			huge_page_size;
 int			huge_pages_status = HUGE_PAGES_UNKNOWN;
+bool		numa_interleave = false;
 
 /*
  * These variables are all dummies that don't do anything, except in some
@@ -869,6 +876,30 @@ struct config_bool ConfigureNamesBool[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"hashagg_spill_compress", PGC_USERSET, RESOURCES_DISK,
+			gettext_noop("Compresses hashed aggregation spill data."),
+			gettext_noop("Spilled tuples are pglz-compressed on disk, trading "
+						 "CPU for temporary file volume."),
+			GUC_EXPLAIN
+		},
+		&hashagg_spill_compress,
+		false,
+		NULL, NULL, NULL
+	},
+	{
+		{"tuplestore_spill_compress", PGC_USERSET, RESOURCES_DISK,
+			gettext_noop("Compresses tuple store spill data."),
+			gettext_noop("Tuples spilled to disk by tuple stores (used by "
+						 "materialization, CTEs and window functions) are "
+						 "pglz-compressed, trading CPU for temporary file "
+						 "volume."),
+			GUC_EXPLAIN
+		},
+		&tuplestore_spill_compress,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"enable_material", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enables the planner's use of materialization."),
@@ -1122,6 +1153,17 @@ struct config_bool ConfigureNamesBool[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"ssl_ktls", PGC_SIGHUP, CONN_AUTH_SSL,
+			gettext_noop("Requests kernel TLS offload for SSL connections."),
+			gettext_noop("This is effective only when the OpenSSL build, kernel, "
+						 "and negotiated cipher all support kernel TLS; otherwise "
+						 "TLS processing stays in userspace.")
+		},
+		&SSLKernelTLS,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"fsync", PGC_SIGHUP, WAL_SETTINGS,
 			gettext_noop("Forces synchronization of updates to disk."),
@@ -2060,6 +2102,17 @@ struct config_bool ConfigureNamesBool[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"jit_cache_expressions", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Allow reuse of JIT-compiled expressions across queries."),
+			NULL,
+			GUC_NOT_IN_SAMPLE
+		},
+		&jit_cache_expressions,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"jit_profiling_support", PGC_SU_BACKEND, DEVELOPER_OPTIONS,
 			gettext_noop("Register JIT-compiled functions with perf profiler."),
@@ -2088,6 +2141,16 @@ struct config_bool ConfigureNamesBool[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"numa_interleave", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Interleaves shared memory across all NUMA nodes."),
+			NULL
+		},
+		&numa_interleave,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"data_sync_retry", PGC_POSTMASTER, ERROR_HANDLING_OPTIONS,
 			gettext_noop("Whether to continue running after a failure to sync data files."),
@@ -2562,6 +2625,18 @@ struct config_int ConfigureNamesInt[] =
 		NULL, NULL, show_data_directory_mode
 	},
 
+	{
+		{"parallel_tuple_queue_size", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Sets the size of the queue used to transfer tuples from each parallel worker to the leader."),
+			gettext_noop("Larger queues let workers run further ahead of the leader "
+						 "before stalling, at the cost of shared memory per worker."),
+			GUC_UNIT_KB | GUC_EXPLAIN
+		},
+		&parallel_tuple_queue_size,
+		64, 16, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"work_mem", PGC_USERSET, RESOURCES_MEM,
 			gettext_noop("Sets the maximum memory to be used for query workspaces."),
@@ -3017,6 +3092,16 @@ struct config_int ConfigureNamesInt[] =
 		check_wal_buffers, NULL, NULL
 	},
 
+	{
+		{"wal_compression_level", PGC_SUSET, WAL_SETTINGS,
+			gettext_noop("Sets the compression level used by \"wal_compression\"."),
+			gettext_noop("Currently only used by zstd compression.")
+		},
+		&wal_compression_level,
+		3, -7, 22,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"wal_writer_delay", PGC_SIGHUP, WAL_SETTINGS,
 			gettext_noop("Time between WAL flushes performed in the WAL writer."),
@@ -330,6 +330,19 @@ ltsReadFillBuffer(LogicalTape *lt)
 		/* Advance to next block, if we have buffer space left */
 	} while (lt->buffer_size - lt->nbytes > BLCKSZ);
 
+	/*
+	 * Ask the kernel to start reading the next bufferload while the caller
+	 * consumes this one.  Tape blocks are chained, so we only know the first
+	 * block of the next bufferload for certain; but blocks of a run are
+	 * nearly always allocated sequentially, so prefetching a bufferload's
+	 * worth of consecutive blocks from there is a good bet, and a useless
+	 * prefetch is merely a wasted hint.
+	 */
+	if (lt->nextBlockNumber != -1L)
+		BufFilePrefetchBlocks(lt->tapeSet->pfile,
+							  lt->nextBlockNumber + lt->offsetBlockNumber,
+							  lt->buffer_size / BLCKSZ);
+
 	return (lt->nbytes > 0);
 }
 
@@ -23,8 +23,8 @@
 
 #include "access/htup.h"
 #include "access/htup_details.h"
+#include "port/atomics.h"
 #include "storage/buffile.h"
-#include "storage/lwlock.h"
 #include "storage/sharedfileset.h"
 #include "utils/sharedtuplestore.h"
 
@@ -46,11 +46,18 @@ typedef struct SharedTuplestoreChunk
 	char		data[FLEXIBLE_ARRAY_MEMBER];
 } SharedTuplestoreChunk;
 
-/* Per-participant shared state. */
+/*
+ * Per-participant shared state.
+ *
+ * Chunks are handed out to readers by atomically advancing read_page, so
+ * that concurrent scanners of the same file are never serialized on a lock.
+ * npages is only changed by the owning participant, and all writers must
+ * finish (with the implied memory barriers) before any reads begin, so the
+ * readers always see its final value.
+ */
 typedef struct SharedTuplestoreParticipant
 {
-	LWLock		lock;
-	BlockNumber read_page;		/* Page number for next read. */
+	pg_atomic_uint32 read_page; /* Page number for next read. */
 	BlockNumber npages;			/* Number of pages written. */
 	bool		writing;		/* Used only for assertions. */
 } SharedTuplestoreParticipant;
@@ -154,9 +161,7 @@ sts_initialize(SharedTuplestore *sts, int participants,
 
 	for (i = 0; i < participants; ++i)
 	{
-		LWLockInitialize(&sts->participants[i].lock,
-						 LWTRANCHE_SHARED_TUPLESTORE);
-		sts->participants[i].read_page = 0;
+		pg_atomic_init_u32(&sts->participants[i].read_page, 0);
 		sts->participants[i].npages = 0;
 		sts->participants[i].writing = false;
 	}
@@ -242,7 +247,7 @@ sts_reinitialize(SharedTuplestoreAccessor *accessor)
 	 */
 	for (i = 0; i < accessor->sts->nparticipants; ++i)
 	{
-		accessor->sts->participants[i].read_page = 0;
+		pg_atomic_write_u32(&accessor->sts->participants[i].read_page, 0);
 	}
 }
 
@@ -507,20 +512,29 @@ sts_parallel_scan_next(SharedTuplestoreAccessor *accessor, void *meta_data)
 		/* Find the location of a new chunk to read. */
 		p = &accessor->sts->participants[accessor->read_participant];
 
-		LWLockAcquire(&p->lock, LW_EXCLUSIVE);
-		/* We can skip directly past overflow pages we know about. */
-		if (p->read_page < accessor->read_next_page)
-			p->read_page = accessor->read_next_page;
-		eof = p->read_page >= p->npages;
-		if (!eof)
+		/*
+		 * Claim the next chunk by atomically advancing the shared read head.
+		 * If we know about overflow pages that the shared read head hasn't
+		 * reached yet, we try to push it past them, so that other readers
+		 * don't waste time claiming them.
+		 */
+		read_page = pg_atomic_read_u32(&p->read_page);
+		for (;;)
 		{
-			/* Claim the next chunk. */
-			read_page = p->read_page;
-			/* Advance the read head for the next reader. */
-			p->read_page += STS_CHUNK_PAGES;
-			accessor->read_next_page = p->read_page;
+			BlockNumber claim_page = Max(read_page, accessor->read_next_page);
+
+			eof = claim_page >= p->npages;
+			if (eof)
+				break;
+			if (pg_atomic_compare_exchange_u32(&p->read_page,
+											   &read_page,
+											   claim_page + STS_CHUNK_PAGES))
+			{
+				read_page = claim_page;
+				accessor->read_next_page = claim_page + STS_CHUNK_PAGES;
+				break;
+			}
 		}
-		LWLockRelease(&p->lock);
 
 		if (!eof)
 		{
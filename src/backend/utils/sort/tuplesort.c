@@ -190,6 +190,11 @@ struct Tuplesortstate
 								 * tuples to return? */
 	bool		boundUsed;		/* true if we made use of a bounded heap */
 	int			bound;			/* if bounded, the maximum number of tuples */
+	pg_atomic_uint64 *sharedBoundKey;	/* bound shared with other processes
+										 * sorting partitions of the same
+										 * input, or NULL */
+	bool		sharedBoundActive;	/* is datum1 usable against it? */
+	bool		sharedBoundFlip;	/* invert key bits (DESC leading key)? */
 	int64		tupleMem;		/* memory consumed by individual tuples.
 								 * storing this separately from what we track
 								 * in availMem allows us to subtract the
@@ -463,6 +468,7 @@ static void beginmerge(Tuplesortstate *state);
 static bool mergereadnext(Tuplesortstate *state, LogicalTape *srcTape, SortTuple *stup);
 static void dumptuples(Tuplesortstate *state, bool alltuples);
 static void make_bounded_heap(Tuplesortstate *state);
+static void tuplesort_publish_shared_bound(Tuplesortstate *state);
 static void sort_bounded_heap(Tuplesortstate *state);
 static void tuplesort_sort_memtuples(Tuplesortstate *state);
 static void tuplesort_heap_insert(Tuplesortstate *state, SortTuple *tuple);
@@ -567,6 +573,11 @@ qsort_tuple_int32_compare(SortTuple *a, SortTuple *b, Tuplesortstate *state)
  * reduces to ApplySortComparator(), that is single-key MinimalTuple sorts
  * and Datum sorts.  qsort_tuple_{unsigned,signed,int32} are specialized for
  * common comparison functions on pass-by-value leading datums.
+ *
+ * The fixed-width-key specializations use a larger insertion sort threshold
+ * than the template default: their leading-key comparison inlines to a few
+ * instructions, so small partitions are finished more cheaply by insertion
+ * sort than by another round of pivot selection and partitioning.
  */
 
 #define ST_SORT qsort_tuple_unsigned
@@ -574,6 +585,7 @@ qsort_tuple_int32_compare(SortTuple *a, SortTuple *b, Tuplesortstate *state)
 #define ST_COMPARE(a, b, state) qsort_tuple_unsigned_compare(a, b, state)
 #define ST_COMPARE_ARG_TYPE Tuplesortstate
 #define ST_CHECK_FOR_INTERRUPTS
+#define ST_INSERTION_SORT_THRESHOLD 16
 #define ST_SCOPE static
 #define ST_DEFINE
 #include "lib/sort_template.h"
@@ -584,6 +596,7 @@ qsort_tuple_int32_compare(SortTuple *a, SortTuple *b, Tuplesortstate *state)
 #define ST_COMPARE(a, b, state) qsort_tuple_signed_compare(a, b, state)
 #define ST_COMPARE_ARG_TYPE Tuplesortstate
 #define ST_CHECK_FOR_INTERRUPTS
+#define ST_INSERTION_SORT_THRESHOLD 16
 #define ST_SCOPE static
 #define ST_DEFINE
 #include "lib/sort_template.h"
@@ -594,6 +607,7 @@ qsort_tuple_int32_compare(SortTuple *a, SortTuple *b, Tuplesortstate *state)
 #define ST_COMPARE(a, b, state) qsort_tuple_int32_compare(a, b, state)
 #define ST_COMPARE_ARG_TYPE Tuplesortstate
 #define ST_CHECK_FOR_INTERRUPTS
+#define ST_INSERTION_SORT_THRESHOLD 16
 #define ST_SCOPE static
 #define ST_DEFINE
 #include "lib/sort_template.h"
@@ -781,6 +795,9 @@ tuplesort_begin_batch(Tuplesortstate *state)
 	state->status = TSS_INITIAL;
 	state->bounded = false;
 	state->boundUsed = false;
+	state->sharedBoundKey = NULL;
+	state->sharedBoundActive = false;
+	state->sharedBoundFlip = false;
 
 	state->availMem = state->allowedMem;
 
@@ -888,6 +905,24 @@ tuplesort_used_bound(Tuplesortstate *state)
 	return state->boundUsed;
 }
 
+/*
+ * tuplesort_set_shared_bound
+ *
+ *	Point a bounded sort at a leading-key bound shared with other processes
+ *	sorting partitions of the same input; see SharedSortBound.  Ignored
+ *	unless tuplesort_set_bound was also called.  Whether the bound can
+ *	actually be used is decided when the bounded heap is built, since it
+ *	requires the leading-key ordering to be fully determined by datum1.
+ */
+void
+tuplesort_set_shared_bound(Tuplesortstate *state, pg_atomic_uint64 *bound_key)
+{
+	/* Assert we're called before loading any tuples */
+	Assert(state->status == TSS_INITIAL && state->memtupcount == 0);
+
+	state->sharedBoundKey = bound_key;
+}
+
 /*
  * tuplesort_free
  *
@@ -1281,6 +1316,27 @@ tuplesort_puttuple_common(Tuplesortstate *state, SortTuple *tuple,
 			 * with just this one comparison.  Note that because we currently
 			 * have the sort direction reversed, we must check for <= not >=.
 			 */
+			if (state->sharedBoundActive && !tuple->isnull1)
+			{
+				uint64		key = DatumGetUInt64(tuple->datum1);
+
+				if (state->sharedBoundFlip)
+					key = ~key;
+
+				/*
+				 * If the tuple's leading key is strictly beyond the tightest
+				 * bound published by any cooperating process, at least
+				 * "bound" tuples sorting before it exist over there, so it
+				 * can't be needed no matter what our own heap holds.
+				 */
+				if (key > pg_atomic_read_u64(state->sharedBoundKey))
+				{
+					free_sort_tuple(state, tuple);
+					CHECK_FOR_INTERRUPTS();
+					break;
+				}
+			}
+
 			if (COMPARETUP(state, tuple, &state->memtuples[0]) <= 0)
 			{
 				/* new tuple <= top of the heap, so we can discard it */
@@ -1292,6 +1348,8 @@ tuplesort_puttuple_common(Tuplesortstate *state, SortTuple *tuple,
 				/* discard top of heap, replacing it with the new tuple */
 				free_sort_tuple(state, &state->memtuples[0]);
 				tuplesort_heap_replace_top(state, tuple);
+				if (state->sharedBoundActive)
+					tuplesort_publish_shared_bound(state);
 			}
 			break;
 
@@ -1651,6 +1709,32 @@ tuplesort_gettuple_common(Tuplesortstate *state, bool forward,
 				state->lastReturnedTuple = NULL;
 			}
 
+			/*
+			 * Once a single input run remains, the "merge" is a straight
+			 * read of that tape, so stream tuples through the top heap entry
+			 * without any heap maintenance or comparisons.  This covers the
+			 * tail of every merge, and in parallel sorts it covers the whole
+			 * merge whenever only one worker produced any tuples.
+			 */
+			if (state->memtupcount == 1)
+			{
+				int			srcTapeIndex = state->memtuples[0].srctape;
+				LogicalTape *srcTape = state->inputTapes[srcTapeIndex];
+
+				*stup = state->memtuples[0];
+				state->lastReturnedTuple = stup->tuple;
+
+				if (!mergereadnext(state, srcTape, &state->memtuples[0]))
+				{
+					state->memtupcount = 0;
+					state->nInputRuns--;
+					LogicalTapeClose(srcTape);
+				}
+				else
+					state->memtuples[0].srctape = srcTapeIndex;
+				return true;
+			}
+
 			/*
 			 * This code should match the inner loop of mergeonerun().
 			 */
@@ -2597,6 +2681,24 @@ make_bounded_heap(Tuplesortstate *state)
 	/* Reverse sort direction so largest entry will be at root */
 	reversedirection(state);
 
+	/*
+	 * A shared bound can only be consulted when comparing leading datum1
+	 * keys is a total order on tuples' leading keys, i.e. when the leading
+	 * comparator is the raw unsigned comparison and no abbreviation is in
+	 * play (tuplesort_set_bound disabled abbreviation already).  Note that
+	 * the direction was just reversed, so the original descending case is
+	 * the one where ssup_reverse now reads false.
+	 */
+	if (state->sharedBoundKey != NULL &&
+		state->base.haveDatum1 &&
+		state->base.sortKeys != NULL &&
+		state->base.sortKeys[0].abbrev_converter == NULL &&
+		state->base.sortKeys[0].comparator == ssup_datum_unsigned_cmp)
+	{
+		state->sharedBoundActive = true;
+		state->sharedBoundFlip = !state->base.sortKeys[0].ssup_reverse;
+	}
+
 	state->memtupcount = 0;		/* make the heap empty */
 	for (i = 0; i < tupcount; i++)
 	{
@@ -2626,9 +2728,40 @@ make_bounded_heap(Tuplesortstate *state)
 	}
 
 	Assert(state->memtupcount == state->bound);
+	if (state->sharedBoundActive)
+		tuplesort_publish_shared_bound(state);
 	state->status = TSS_BOUNDED;
 }
 
+/*
+ * Publish our bounded heap's current maximum as a candidate for the shared
+ * leading-key bound, if it improves on what's there.  The shared value only
+ * ever decreases, so a stale read just costs one extra CAS iteration.
+ */
+static void
+tuplesort_publish_shared_bound(Tuplesortstate *state)
+{
+	uint64		key;
+	uint64		cur;
+
+	Assert(state->sharedBoundActive);
+
+	/* a NULL heap maximum gives us no usable leading-key bound */
+	if (state->memtuples[0].isnull1)
+		return;
+
+	key = DatumGetUInt64(state->memtuples[0].datum1);
+	if (state->sharedBoundFlip)
+		key = ~key;
+
+	cur = pg_atomic_read_u64(state->sharedBoundKey);
+	while (key < cur)
+	{
+		if (pg_atomic_compare_exchange_u64(state->sharedBoundKey, &cur, key))
+			break;
+	}
+}
+
 /*
  * Convert the bounded heap to a properly-sorted array
  */
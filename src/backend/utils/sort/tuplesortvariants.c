@@ -26,6 +26,7 @@
 #include "access/nbtree.h"
 #include "catalog/index.h"
 #include "catalog/pg_collation.h"
+#include "catalog/pg_operator.h"
 #include "executor/executor.h"
 #include "pg_trace.h"
 #include "utils/datum.h"
@@ -52,6 +53,8 @@ static void removeabbrev_index_gin(Tuplesortstate *state, SortTuple *stups,
 								   int count);
 static void removeabbrev_datum(Tuplesortstate *state, SortTuple *stups,
 							   int count);
+static Datum heap_pack_datum1(TuplesortPublic *base, HeapTuple htup,
+							  TupleDesc tupDesc, bool *isnull);
 static int	comparetup_heap(const SortTuple *a, const SortTuple *b,
 							Tuplesortstate *state);
 static int	comparetup_heap_tiebreak(const SortTuple *a, const SortTuple *b,
@@ -242,6 +245,60 @@ tuplesort_begin_heap(TupleDesc tupDesc,
 	if (nkeys == 1 && !base->sortKeys->abbrev_converter)
 		base->onlyKey = base->sortKeys;
 
+#if SIZEOF_DATUM >= 8
+
+	/*
+	 * If the two leading keys are int4 columns using the standard ordering
+	 * operators, encode both of them into datum1: the first key's bits go in
+	 * the high word and the second key's in the low word, each transformed so
+	 * that an unsigned comparison of the combined value matches the desired
+	 * per-key orderings.  The leading comparison then resolves two keys at
+	 * once, and qualifies for the unsigned-comparison sort specialization.
+	 *
+	 * The low-word encoding is lossy across NULL/non-NULL boundaries (a NULL
+	 * second key shares its encoding with INT_MIN or INT_MAX), but that's
+	 * fine: comparetup_heap_tiebreak recomparisons start at the second key
+	 * whenever there's no abbreviation, so any packed-value tie is broken by
+	 * comparing the real column values.
+	 */
+	if (nkeys >= 2 &&
+		!base->sortKeys[0].abbrev_converter &&
+		(sortOperators[0] == Int4LessOperator ||
+		 sortOperators[0] == Int4GreaterOperator) &&
+		(sortOperators[1] == Int4LessOperator ||
+		 sortOperators[1] == Int4GreaterOperator))
+	{
+		bool		reverse1 = (sortOperators[0] == Int4GreaterOperator);
+		bool		reverse2 = (sortOperators[1] == Int4GreaterOperator);
+
+		Assert(base->sortKeys[0].ssup_reverse == reverse1);
+
+		base->packKeys = true;
+		base->packAttno2 = attNums[1];
+
+		/*
+		 * ApplySortComparator inverts the whole comparison when the first
+		 * key is descending, so the second key's bits only need their own
+		 * inversion when its direction differs from the first key's: flip
+		 * the sign bit for the same direction, or additionally complement
+		 * the value bits for the opposite direction.
+		 */
+		base->packLoXor = (reverse2 == reverse1) ? 0x80000000 : 0x7FFFFFFF;
+
+		/*
+		 * Pick the low-word encoding that places a NULL second key at the
+		 * right end of its group, accounting for the same whole-comparison
+		 * inversion.
+		 */
+		if (nullsFirstFlags[1] != reverse1)
+			base->packLoNull = 0;
+		else
+			base->packLoNull = 0xFFFFFFFF;
+
+		base->sortKeys[0].comparator = ssup_datum_unsigned_cmp;
+	}
+#endif
+
 	MemoryContextSwitchTo(oldcontext);
 
 	return state;
@@ -747,10 +804,13 @@ tuplesort_puttupleslot(Tuplesortstate *state, TupleTableSlot *slot)
 	/* set up first-column key value */
 	htup.t_len = tuple->t_len + MINIMAL_TUPLE_OFFSET;
 	htup.t_data = (HeapTupleHeader) ((char *) tuple - MINIMAL_TUPLE_OFFSET);
-	stup.datum1 = heap_getattr(&htup,
-							   base->sortKeys[0].ssup_attno,
-							   tupDesc,
-							   &stup.isnull1);
+	if (base->packKeys)
+		stup.datum1 = heap_pack_datum1(base, &htup, tupDesc, &stup.isnull1);
+	else
+		stup.datum1 = heap_getattr(&htup,
+								   base->sortKeys[0].ssup_attno,
+								   tupDesc,
+								   &stup.isnull1);
 
 	/* GetMemoryChunkSpace is not supported for bump contexts */
 	if (TupleSortUseBumpTupleCxt(base->sortopt))
@@ -1179,6 +1239,37 @@ tuplesort_getdatum(Tuplesortstate *state, bool forward, bool copy,
  * Routines specialized for HeapTuple (actually MinimalTuple) case
  */
 
+/*
+ * Compute the packed datum1 encoding the two leading int4 keys, per the
+ * transforms chosen in tuplesort_begin_heap.  isnull1 continues to reflect
+ * the first key alone; a NULL first key leaves the packed value unused.
+ */
+static Datum
+heap_pack_datum1(TuplesortPublic *base, HeapTuple htup, TupleDesc tupDesc,
+				 bool *isnull)
+{
+	Datum		datum1;
+	Datum		datum2;
+	bool		isnull2;
+	uint32		hi;
+	uint32		lo;
+
+	datum1 = heap_getattr(htup, base->sortKeys[0].ssup_attno, tupDesc, isnull);
+	if (*isnull)
+		return (Datum) 0;
+
+	datum2 = heap_getattr(htup, base->packAttno2, tupDesc, &isnull2);
+
+	/* flip the sign bit so that unsigned comparison orders int4 values */
+	hi = (uint32) DatumGetInt32(datum1) ^ 0x80000000;
+	if (isnull2)
+		lo = base->packLoNull;
+	else
+		lo = (uint32) DatumGetInt32(datum2) ^ base->packLoXor;
+
+	return (Datum) (((uint64) hi << 32) | lo);
+}
+
 static void
 removeabbrev_heap(Tuplesortstate *state, SortTuple *stups, int count)
 {
@@ -1312,10 +1403,14 @@ readtup_heap(Tuplesortstate *state, SortTuple *stup,
 	/* set up first-column key value */
 	htup.t_len = tuple->t_len + MINIMAL_TUPLE_OFFSET;
 	htup.t_data = (HeapTupleHeader) ((char *) tuple - MINIMAL_TUPLE_OFFSET);
-	stup->datum1 = heap_getattr(&htup,
-								base->sortKeys[0].ssup_attno,
-								(TupleDesc) base->arg,
-								&stup->isnull1);
+	if (base->packKeys)
+		stup->datum1 = heap_pack_datum1(base, &htup, (TupleDesc) base->arg,
+										&stup->isnull1);
+	else
+		stup->datum1 = heap_getattr(&htup,
+									base->sortKeys[0].ssup_attno,
+									(TupleDesc) base->arg,
+									&stup->isnull1);
 }
 
 /*
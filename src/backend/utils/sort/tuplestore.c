@@ -58,6 +58,7 @@
 
 #include "access/htup_details.h"
 #include "commands/tablespace.h"
+#include "common/pg_lzcompress.h"
 #include "executor/executor.h"
 #include "miscadmin.h"
 #include "storage/buffile.h"
@@ -182,6 +183,19 @@ struct Tuplestorestate
 	off_t		writepos_offset;	/* offset (valid if READFILE state) */
 };
 
+/*
+ * Stored length words are real on-tape sizes, but their high bit flags a
+ * pglz-compressed tuple body; mask it off before using a length word for
+ * seek arithmetic.  Bodies smaller than TSTORE_SPILL_COMPRESS_MIN bytes
+ * are unlikely to compress usefully, so don't bother trying.
+ */
+#define TSTORE_SPILL_COMPRESSED		0x80000000u
+#define TSTORE_SPILL_COMPRESS_MIN	64
+#define TSTORE_TUPLEN(len)	((len) & ~TSTORE_SPILL_COMPRESSED)
+
+/* GUC variable */
+bool		tuplestore_spill_compress = false;
+
 #define COPYTUP(state,tup)	((*(state)->copytup) (state, tup))
 #define WRITETUP(state,tup) ((*(state)->writetup) (state, tup))
 #define READTUP(state,len)	((*(state)->readtup) (state, len))
@@ -1072,7 +1086,8 @@ tuplestore_gettuple(Tuplestorestate *state, bool forward,
 				 * Back up to get ending length word of tuple before it.
 				 */
 				if (BufFileSeek(state->myfile, 0,
-								-(long) (tuplen + 2 * sizeof(unsigned int)),
+								-(long) (TSTORE_TUPLEN(tuplen) +
+										 2 * sizeof(unsigned int)),
 								SEEK_CUR) != 0)
 				{
 					/*
@@ -1082,7 +1097,8 @@ tuplestore_gettuple(Tuplestorestate *state, bool forward,
 					 * what in-memory case does).
 					 */
 					if (BufFileSeek(state->myfile, 0,
-									-(long) (tuplen + sizeof(unsigned int)),
+									-(long) (TSTORE_TUPLEN(tuplen) +
+											 sizeof(unsigned int)),
 									SEEK_CUR) != 0)
 						ereport(ERROR,
 								(errcode_for_file_access(),
@@ -1099,7 +1115,7 @@ tuplestore_gettuple(Tuplestorestate *state, bool forward,
 			 * length word of the tuple, so back up to that point.
 			 */
 			if (BufFileSeek(state->myfile, 0,
-							-(long) tuplen,
+							-(long) TSTORE_TUPLEN(tuplen),
 							SEEK_CUR) != 0)
 				ereport(ERROR,
 						(errcode_for_file_access(),
@@ -1607,6 +1623,41 @@ writetup_heap(Tuplestorestate *state, void *tup)
 	/* total on-disk footprint: */
 	unsigned int tuplen = tupbodylen + sizeof(int);
 
+	/*
+	 * If enabled, try to compress the tuple body.  Only use the result if it
+	 * actually saves space after the extra word recording the raw length.
+	 * The length words hold the real on-tape footprint, flagged so that
+	 * readtup_heap knows to decompress.
+	 */
+	if (tuplestore_spill_compress && tupbodylen >= TSTORE_SPILL_COMPRESS_MIN)
+	{
+		char	   *cbuf = palloc(PGLZ_MAX_OUTPUT(tupbodylen));
+		int32		clen;
+
+		clen = pglz_compress(tupbody, tupbodylen, cbuf,
+							 PGLZ_strategy_default);
+		if (clen >= 0 &&
+			clen + sizeof(unsigned int) < (Size) tupbodylen)
+		{
+			unsigned int rawbodylen = tupbodylen;
+			unsigned int ctuplen;
+
+			ctuplen = (sizeof(unsigned int) + clen + sizeof(int)) |
+				TSTORE_SPILL_COMPRESSED;
+			BufFileWrite(state->myfile, &ctuplen, sizeof(ctuplen));
+			BufFileWrite(state->myfile, &rawbodylen, sizeof(rawbodylen));
+			BufFileWrite(state->myfile, cbuf, clen);
+			if (state->backward) /* need trailing length word? */
+				BufFileWrite(state->myfile, &ctuplen, sizeof(ctuplen));
+			pfree(cbuf);
+
+			FREEMEM(state, GetMemoryChunkSpace(tuple));
+			heap_free_minimal_tuple(tuple);
+			return;
+		}
+		pfree(cbuf);
+	}
+
 	BufFileWrite(state->myfile, &tuplen, sizeof(tuplen));
 	BufFileWrite(state->myfile, tupbody, tupbodylen);
 	if (state->backward)		/* need trailing length word? */
@@ -1619,10 +1670,40 @@ writetup_heap(Tuplestorestate *state, void *tup)
 static void *
 readtup_heap(Tuplestorestate *state, unsigned int len)
 {
-	unsigned int tupbodylen = len - sizeof(int);
-	unsigned int tuplen = tupbodylen + MINIMAL_TUPLE_DATA_OFFSET;
-	MinimalTuple tuple = (MinimalTuple) palloc(tuplen);
-	char	   *tupbody = (char *) tuple + MINIMAL_TUPLE_DATA_OFFSET;
+	unsigned int tupbodylen;
+	unsigned int tuplen;
+	MinimalTuple tuple;
+	char	   *tupbody;
+
+	if (len & TSTORE_SPILL_COMPRESSED)
+	{
+		unsigned int clen = TSTORE_TUPLEN(len) - sizeof(int) -
+			sizeof(unsigned int);
+		char	   *cbuf;
+
+		BufFileReadExact(state->myfile, &tupbodylen, sizeof(tupbodylen));
+		cbuf = palloc(clen);
+		BufFileReadExact(state->myfile, cbuf, clen);
+
+		tuplen = tupbodylen + MINIMAL_TUPLE_DATA_OFFSET;
+		tuple = (MinimalTuple) palloc(tuplen);
+		tupbody = (char *) tuple + MINIMAL_TUPLE_DATA_OFFSET;
+		tuple->t_len = tuplen;
+		if (pglz_decompress(cbuf, clen, tupbody, tupbodylen, true) !=
+			(int32) tupbodylen)
+			ereport(ERROR,
+					(errcode(ERRCODE_DATA_CORRUPTED),
+					 errmsg_internal("compressed tuplestore tuple is corrupt")));
+		pfree(cbuf);
+		if (state->backward)	/* need trailing length word? */
+			BufFileReadExact(state->myfile, &tuplen, sizeof(tuplen));
+		return tuple;
+	}
+
+	tupbodylen = len - sizeof(int);
+	tuplen = tupbodylen + MINIMAL_TUPLE_DATA_OFFSET;
+	tuple = (MinimalTuple) palloc(tuplen);
+	tupbody = (char *) tuple + MINIMAL_TUPLE_DATA_OFFSET;
 
 	/* read in the tuple proper */
 	tuple->t_len = tuplen;
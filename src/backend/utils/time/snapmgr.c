@@ -254,6 +254,8 @@ typedef struct SerializedSnapshotData
 	uint32		xcnt;
 	int32		subxcnt;
 	bool		suboverflowed;
+	SubxidFilter subxfilter;
+	bool		subxfilter_valid;
 	bool		takenDuringRecovery;
 	CommandId	curcid;
 } SerializedSnapshotData;
@@ -532,6 +534,8 @@ SetTransactionSnapshot(Snapshot sourcesnap, VirtualTransactionId *sourcevxid,
 		memcpy(CurrentSnapshot->subxip, sourcesnap->subxip,
 			   sourcesnap->subxcnt * sizeof(TransactionId));
 	CurrentSnapshot->suboverflowed = sourcesnap->suboverflowed;
+	CurrentSnapshot->subxfilter = sourcesnap->subxfilter;
+	CurrentSnapshot->subxfilter_valid = sourcesnap->subxfilter_valid;
 	CurrentSnapshot->takenDuringRecovery = sourcesnap->takenDuringRecovery;
 	/* NB: curcid should NOT be copied, it's a local matter */
 
@@ -1482,6 +1486,9 @@ ImportSnapshot(const char *idstr)
 
 	snapshot.suboverflowed = parseIntFromText("sof:", &filebuf, path);
 
+	/* exported snapshot files don't carry a subxid filter */
+	snapshot.subxfilter_valid = false;
+
 	if (!snapshot.suboverflowed)
 	{
 		snapshot.subxcnt = xcnt = parseIntFromText("sxcnt:", &filebuf, path);
@@ -1732,6 +1739,8 @@ SerializeSnapshot(Snapshot snapshot, char *start_address)
 	serialized_snapshot.xcnt = snapshot->xcnt;
 	serialized_snapshot.subxcnt = snapshot->subxcnt;
 	serialized_snapshot.suboverflowed = snapshot->suboverflowed;
+	serialized_snapshot.subxfilter = snapshot->subxfilter;
+	serialized_snapshot.subxfilter_valid = snapshot->subxfilter_valid;
 	serialized_snapshot.takenDuringRecovery = snapshot->takenDuringRecovery;
 	serialized_snapshot.curcid = snapshot->curcid;
 
@@ -1804,6 +1813,8 @@ RestoreSnapshot(char *start_address)
 	snapshot->subxip = NULL;
 	snapshot->subxcnt = serialized_snapshot.subxcnt;
 	snapshot->suboverflowed = serialized_snapshot.suboverflowed;
+	snapshot->subxfilter = serialized_snapshot.subxfilter;
+	snapshot->subxfilter_valid = serialized_snapshot.subxfilter_valid;
 	snapshot->takenDuringRecovery = serialized_snapshot.takenDuringRecovery;
 	snapshot->curcid = serialized_snapshot.curcid;
 	snapshot->snapXactCompletionCount = 0;
@@ -1894,6 +1905,18 @@ XidInMVCCSnapshot(TransactionId xid, Snapshot snapshot)
 
 			/* not there, fall through to search xip[] */
 		}
+		else if (snapshot->subxfilter_valid &&
+				 !SubxidFilterMayContain(&snapshot->subxfilter, xid))
+		{
+			/*
+			 * Snapshot overflowed, but the filter shows that xid cannot be a
+			 * subtransaction of any transaction that was in progress when
+			 * the snapshot was taken, so skip the pg_subtrans lookup and
+			 * fall through to search xip[] for xid itself.  (If xid belongs
+			 * to an already-finished transaction, its parent cannot be in
+			 * xip[] either, so the answer comes out the same.)
+			 */
+		}
 		else
 		{
 			/*
@@ -0,0 +1,350 @@
+/*
+ *	pg_bench_micro --- microbenchmarks for low-level primitives
+ *
+ *	Copyright (c) 2026, PostgreSQL Global Development Group
+ *
+ *	src/bin/pg_bench_micro/pg_bench_micro.c
+ */
+#include "postgres_fe.h"
+
+#include "common/hashfn.h"
+#include "common/hashfn_unstable.h"
+#include "common/logging.h"
+#include "common/pg_prng.h"
+#include "getopt_long.h"
+#include "port/pg_crc32c.h"
+#include "port/pg_lfind.h"
+#include "portability/instr_time.h"
+
+/* instantiate a type-specialized sort for the qsort benchmark */
+#define ST_SORT sort_uint32
+#define ST_ELEMENT_TYPE uint32
+#define ST_COMPARE(a, b) (((*(a)) > (*(b))) - ((*(a)) < (*(b))))
+#define ST_SCOPE static
+#define ST_DEFINE
+#include "lib/sort_template.h"
+
+static const char *progname;
+
+/* Command line options and defaults */
+static unsigned int secs_per_test = 2;
+static bool output_json = false;
+
+/* Benchmark working set sizes */
+#define SMALL_KEY_LEN	32		/* typical catcache/dynahash key */
+#define LARGE_BUF_LEN	8192	/* one disk page */
+#define LFIND_NELEM		1024	/* typical snapshot xip array sweep */
+#define SORT_NELEM		65536	/* in-memory sort run */
+
+/* Ops per duration check; large enough to amortize the clock read */
+#define BATCH_OPS		4096
+
+static pg_prng_state prng_state;
+static bool first_result = true;
+
+/*
+ * Accumulator defeating dead-code elimination of benchmark bodies.  It is
+ * printed (at debug level only) so the compiler must compute it.
+ */
+static uint64 bench_sink = 0;
+
+static void handle_args(int argc, char *argv[]);
+static void report_result(const char *name, uint64 ops, double elapsed_sec,
+						  uint64 bytes_per_op);
+static void bench_crc32c(void);
+static void bench_hash_bytes(void);
+static void bench_fasthash(void);
+static void bench_lfind32(void);
+static void bench_sort(void);
+
+int
+main(int argc, char *argv[])
+{
+	pg_logging_init(argv[0]);
+	set_pglocale_pgservice(argv[0], PG_TEXTDOMAIN("pg_bench_micro"));
+	progname = get_progname(argv[0]);
+
+	handle_args(argc, argv);
+
+	pg_prng_seed(&prng_state, 0x5eed5eed5eed5eedULL);
+
+	if (output_json)
+		printf("[");
+
+	bench_crc32c();
+	bench_hash_bytes();
+	bench_fasthash();
+	bench_lfind32();
+	bench_sort();
+
+	if (output_json)
+		printf("\n]\n");
+
+	pg_log_debug("checksum of benchmark results: " UINT64_FORMAT, bench_sink);
+
+	return 0;
+}
+
+static void
+handle_args(int argc, char *argv[])
+{
+	static struct option long_options[] = {
+		{"secs-per-test", required_argument, NULL, 's'},
+		{"json", no_argument, NULL, 'j'},
+		{NULL, 0, NULL, 0}
+	};
+
+	int			option;			/* Command line option */
+	int			optindex = 0;	/* used by getopt_long */
+	unsigned long optval;		/* used for option parsing */
+	char	   *endptr;
+
+	if (argc > 1)
+	{
+		if (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-?") == 0)
+		{
+			printf(_("Usage: %s [-s SECS-PER-TEST] [--json]\n"), progname);
+			exit(0);
+		}
+		if (strcmp(argv[1], "--version") == 0 || strcmp(argv[1], "-V") == 0)
+		{
+			puts("pg_bench_micro (PostgreSQL) " PG_VERSION);
+			exit(0);
+		}
+	}
+
+	while ((option = getopt_long(argc, argv, "js:",
+								 long_options, &optindex)) != -1)
+	{
+		switch (option)
+		{
+			case 'j':
+				output_json = true;
+				break;
+
+			case 's':
+				errno = 0;
+				optval = strtoul(optarg, &endptr, 10);
+
+				if (endptr == optarg || *endptr != '\0' ||
+					errno != 0 || optval != (unsigned int) optval ||
+					optval == 0)
+					pg_fatal("invalid argument for option %s", "--secs-per-test");
+				secs_per_test = (unsigned int) optval;
+				break;
+
+			default:
+				/* getopt_long already emitted a complaint */
+				pg_log_error_hint("Try \"%s --help\" for more information.",
+								  progname);
+				exit(1);
+		}
+	}
+
+	if (argc > optind)
+	{
+		pg_log_error("too many command-line arguments (first is \"%s\")",
+					 argv[optind]);
+		pg_log_error_hint("Try \"%s --help\" for more information.",
+						  progname);
+		exit(1);
+	}
+
+	if (!output_json)
+		printf(ngettext("%u second per test\n",
+						"%u seconds per test\n",
+						secs_per_test),
+			   secs_per_test);
+}
+
+/*
+ * Emit one benchmark result, either as a human-readable line or as a JSON
+ * object suitable for diffing across builds and machines.
+ */
+static void
+report_result(const char *name, uint64 ops, double elapsed_sec,
+			  uint64 bytes_per_op)
+{
+	double		ops_per_sec = ops / elapsed_sec;
+
+	if (output_json)
+	{
+		printf("%s\n  {\"name\": \"%s\", \"ops_per_sec\": %.0f",
+			   first_result ? "" : ",", name, ops_per_sec);
+		if (bytes_per_op > 0)
+			printf(", \"mb_per_sec\": %.2f",
+				   ops_per_sec * bytes_per_op / (1024.0 * 1024.0));
+		printf("}");
+		first_result = false;
+	}
+	else
+	{
+		printf("%-24s %15.0f ops/sec", name, ops_per_sec);
+		if (bytes_per_op > 0)
+			printf(" %10.1f MB/sec",
+				   ops_per_sec * bytes_per_op / (1024.0 * 1024.0));
+		printf("\n");
+	}
+	fflush(stdout);
+}
+
+/*
+ * Fill buf with reproducible pseudo-random bytes.
+ */
+static void
+fill_random(void *buf, size_t len)
+{
+	unsigned char *p = buf;
+
+	while (len >= sizeof(uint64))
+	{
+		uint64		v = pg_prng_uint64(&prng_state);
+
+		memcpy(p, &v, sizeof(uint64));
+		p += sizeof(uint64);
+		len -= sizeof(uint64);
+	}
+	while (len > 0)
+	{
+		*p++ = (unsigned char) pg_prng_uint64(&prng_state);
+		len--;
+	}
+}
+
+/*
+ * Run "body" in batches until secs_per_test has elapsed, then report.
+ * "body" must fold its result into bench_sink.
+ */
+#define RUN_BENCH(name, bytes_per_op, body) \
+	do \
+	{ \
+		instr_time	start, \
+					now; \
+		uint64		ops = 0; \
+		double		elapsed; \
+		\
+		INSTR_TIME_SET_CURRENT(start); \
+		do \
+		{ \
+			for (int _i = 0; _i < BATCH_OPS; _i++) \
+			{ \
+				body; \
+			} \
+			ops += BATCH_OPS; \
+			INSTR_TIME_SET_CURRENT(now); \
+			INSTR_TIME_SUBTRACT(now, start); \
+			elapsed = INSTR_TIME_GET_DOUBLE(now); \
+		} while (elapsed < (double) secs_per_test); \
+		report_result(name, ops, elapsed, bytes_per_op); \
+	} while (0)
+
+/*
+ * CRC-32C over one page, exercising the hardware implementation chosen at
+ * startup where available.
+ */
+static void
+bench_crc32c(void)
+{
+	static char buf[LARGE_BUF_LEN];
+
+	fill_random(buf, sizeof(buf));
+
+	RUN_BENCH("crc32c page (8kB)", LARGE_BUF_LEN,
+			  {
+				  pg_crc32c crc;
+
+				  INIT_CRC32C(crc);
+				  COMP_CRC32C(crc, buf, sizeof(buf));
+				  FIN_CRC32C(crc);
+				  bench_sink += crc;
+			  });
+}
+
+/*
+ * The stable Jenkins hash used for on-disk hashing and dynahash, over a
+ * short key and over a page.
+ */
+static void
+bench_hash_bytes(void)
+{
+	static char key[SMALL_KEY_LEN];
+	static char buf[LARGE_BUF_LEN];
+
+	fill_random(key, sizeof(key));
+	fill_random(buf, sizeof(buf));
+
+	RUN_BENCH("hash_bytes key (32B)", SMALL_KEY_LEN,
+			  bench_sink += hash_bytes((unsigned char *) key, sizeof(key)));
+
+	RUN_BENCH("hash_bytes page (8kB)", LARGE_BUF_LEN,
+			  bench_sink += hash_bytes((unsigned char *) buf, sizeof(buf)));
+}
+
+/*
+ * The in-memory fasthash family, same inputs as above for comparison.
+ */
+static void
+bench_fasthash(void)
+{
+	static char key[SMALL_KEY_LEN];
+	static char buf[LARGE_BUF_LEN];
+
+	fill_random(key, sizeof(key));
+	fill_random(buf, sizeof(buf));
+
+	RUN_BENCH("fasthash key (32B)", SMALL_KEY_LEN,
+			  bench_sink += fasthash64(key, sizeof(key), 0));
+
+	RUN_BENCH("fasthash page (8kB)", LARGE_BUF_LEN,
+			  bench_sink += fasthash64(buf, sizeof(buf), 0));
+}
+
+/*
+ * Linear search through a uint32 array with the SIMD helper, mimicking the
+ * snapshot xip lookup pattern.  Searching for an absent key measures the
+ * full-sweep worst case.
+ */
+static void
+bench_lfind32(void)
+{
+	static uint32 arr[LFIND_NELEM];
+
+	for (int i = 0; i < LFIND_NELEM; i++)
+		arr[i] = (uint32) pg_prng_uint64(&prng_state) | 1;
+
+	RUN_BENCH("pg_lfind32 miss (1k)", LFIND_NELEM * sizeof(uint32),
+			  bench_sink += pg_lfind32(0, arr, LFIND_NELEM));
+}
+
+/*
+ * Type-specialized sort from sort_template.h over a shuffled uint32 array.
+ * One "op" is a whole sort, so run small batches.
+ */
+static void
+bench_sort(void)
+{
+	static uint32 input[SORT_NELEM];
+	static uint32 work[SORT_NELEM];
+	instr_time	start,
+				now;
+	uint64		ops = 0;
+	double		elapsed;
+
+	for (int i = 0; i < SORT_NELEM; i++)
+		input[i] = (uint32) pg_prng_uint64(&prng_state);
+
+	INSTR_TIME_SET_CURRENT(start);
+	do
+	{
+		memcpy(work, input, sizeof(input));
+		sort_uint32(work, SORT_NELEM);
+		bench_sink += work[0] + work[SORT_NELEM - 1];
+		ops++;
+		INSTR_TIME_SET_CURRENT(now);
+		INSTR_TIME_SUBTRACT(now, start);
+		elapsed = INSTR_TIME_GET_DOUBLE(now);
+	} while (elapsed < (double) secs_per_test);
+
+	report_result("sort_template u32 (64k)", ops, elapsed,
+				  SORT_NELEM * sizeof(uint32));
+}
@@ -0,0 +1,28 @@
+# Copyright (c) 2026, PostgreSQL Global Development Group
+
+use strict;
+use warnings FATAL => 'all';
+
+use PostgreSQL::Test::Utils;
+use Test::More;
+
+#########################################
+# Basic checks
+
+program_help_ok('pg_bench_micro');
+program_version_ok('pg_bench_micro');
+program_options_handling_ok('pg_bench_micro');
+
+#########################################
+# Test invalid options
+
+command_fails_like(
+	[ 'pg_bench_micro', '--secs-per-test' => 'a' ],
+	qr/\Qpg_bench_micro: error: invalid argument for option --secs-per-test\E/,
+	'pg_bench_micro: invalid argument for option --secs-per-test');
+command_fails_like(
+	[ 'pg_bench_micro', '--secs-per-test' => '0' ],
+	qr/\Qpg_bench_micro: error: invalid argument for option --secs-per-test\E/,
+	'pg_bench_micro: zero seconds per test rejected');
+
+done_testing();
@@ -848,7 +848,8 @@ my %pgdump_runs = (
 #
 # There can be a flag called 'lz4', which can be set if the test
 # case depends on LZ4.  Tests marked with this flag are skipped if
-# the build used does not support LZ4.
+# the build used does not support LZ4.  A 'zstd' flag works the
+# same way for tests depending on ZSTD.
 #
 # Building of this hash takes a bit of time as all of the regexps
 # included in it are compiled.  This greatly improves performance
@@ -3130,6 +3131,31 @@ my %tests = (
 		},
 	},
 
+	'CREATE MATERIALIZED VIEW matview_compression_zstd' => {
+		create_order => 21,
+		create_sql => 'CREATE MATERIALIZED VIEW
+						   dump_test.matview_compression_zstd (col2) AS
+						   SELECT col2 FROM dump_test.test_table;
+						   ALTER MATERIALIZED VIEW dump_test.matview_compression_zstd
+						   ALTER COLUMN col2 SET COMPRESSION zstd;',
+		regexp => qr/^
+			\QCREATE MATERIALIZED VIEW dump_test.matview_compression_zstd AS\E
+			\n\s+\QSELECT col2\E
+			\n\s+\QFROM dump_test.test_table\E
+			\n\s+\QWITH NO DATA;\E
+			.*
+			\QALTER TABLE ONLY dump_test.matview_compression_zstd ALTER COLUMN col2 SET COMPRESSION zstd;\E\n
+			/xms,
+		zstd => 1,
+		like =>
+		  { %full_runs, %dump_test_schema_runs, section_pre_data => 1, },
+		unlike => {
+			exclude_dump_test_schema => 1,
+			no_toast_compression => 1,
+			only_dump_measurement => 1,
+		},
+	},
+
 	'Check ordering of a matview that depends on a primary key' => {
 		create_order => 42,
 		create_sql => '
@@ -3654,6 +3680,30 @@ my %tests = (
 		},
 	},
 
+	'CREATE TABLE test_compression_zstd' => {
+		create_order => 4,
+		create_sql => 'CREATE TABLE dump_test.test_compression_zstd (
+						   col1 int,
+						   col2 text COMPRESSION zstd
+					   );',
+		regexp => qr/^
+			\QCREATE TABLE dump_test.test_compression_zstd (\E\n
+			\s+\Qcol1 integer,\E\n
+			\s+\Qcol2 text\E\n
+			\);\n
+			.*
+			\QALTER TABLE ONLY dump_test.test_compression_zstd ALTER COLUMN col2 SET COMPRESSION zstd;\E\n
+			/xms,
+		zstd => 1,
+		like =>
+		  { %full_runs, %dump_test_schema_runs, section_pre_data => 1, },
+		unlike => {
+			exclude_dump_test_schema => 1,
+			no_toast_compression => 1,
+			only_dump_measurement => 1,
+		},
+	},
+
 	'CREATE TABLE measurement PARTITIONED BY' => {
 		create_order => 90,
 		create_sql => 'CREATE TABLE dump_test.measurement (
@@ -5145,6 +5195,12 @@ foreach my $test (
 			next;
 		}
 
+		# Likewise for tests specific to ZSTD.
+		if (!$supports_zstd && defined($tests{$test}->{zstd}))
+		{
+			next;
+		}
+
 		# Normalize command ending: strip all line endings, add
 		# semicolon if missing, add two newlines.
 		my $create_sql = $tests{$test}->{create_sql};
@@ -5432,6 +5488,12 @@ foreach my $run (sort keys %pgdump_runs)
 			next;
 		}
 
+		# Likewise for tests specific to ZSTD.
+		if (!$supports_zstd && defined($tests{$test}->{zstd}))
+		{
+			next;
+		}
+
 		if ($run_db ne $test_db)
 		{
 			next;
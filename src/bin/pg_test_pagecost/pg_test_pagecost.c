@@ -0,0 +1,433 @@
+/*-------------------------------------------------------------------------
+ *
+ * pg_test_pagecost --- measure sequential vs. random page read cost
+ *
+ * Reads a scratch file the way the server reads heap pages, both
+ * sequentially and at random offsets, and reports the measured rates
+ * together with the random_page_cost setting they imply.
+ *
+ * Portions Copyright (c) 1996-2025, PostgreSQL Global Development Group
+ *
+ * src/bin/pg_test_pagecost/pg_test_pagecost.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres_fe.h"
+
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+
+#include "common/logging.h"
+#include "common/pg_prng.h"
+#include "getopt_long.h"
+
+/*
+ * put the temp file in the local directory
+ * unless the user specifies otherwise
+ */
+#define TEST_FILENAME	"./pg_test_pagecost.out"
+
+#define WRITE_CHUNK_PAGES	128 /* 1MB at the default BLCKSZ */
+#define USECS_SEC			1000000
+
+/* These are macros to avoid timing the function call overhead. */
+#ifndef WIN32
+#define START_TIMER \
+do { \
+	alarm_triggered = false; \
+	alarm(secs_per_test); \
+	gettimeofday(&start_t, NULL); \
+} while (0)
+#else
+/* WIN32 doesn't support alarm, so we create a thread and sleep there */
+#define START_TIMER \
+do { \
+	alarm_triggered = false; \
+	if (CreateThread(NULL, 0, process_alarm, NULL, 0, NULL) == \
+		INVALID_HANDLE_VALUE) \
+		pg_fatal("could not create thread for alarm"); \
+	gettimeofday(&start_t, NULL); \
+} while (0)
+#endif
+
+#define STOP_TIMER	\
+do { \
+	gettimeofday(&stop_t, NULL); \
+} while (0)
+
+
+static const char *progname;
+
+static unsigned int secs_per_test = 5;
+static unsigned int file_size_mb = 1024;
+static int	needs_unlink = 0;
+static char *filename = TEST_FILENAME;
+static char page_buf[BLCKSZ];
+static struct timeval start_t,
+			stop_t;
+static sig_atomic_t alarm_triggered = false;
+
+static uint64 total_pages;
+
+
+static void handle_args(int argc, char *argv[]);
+static void create_test_file(void);
+static void discard_cache(int fd);
+static double test_sequential_reads(void);
+static double test_random_reads(void);
+static void print_suggestion(double seq_rate, double random_rate);
+static double elapsed_secs(struct timeval start, struct timeval stop);
+
+#ifndef WIN32
+static void process_alarm(SIGNAL_ARGS);
+#else
+static DWORD WINAPI process_alarm(LPVOID param);
+#endif
+static void signal_cleanup(SIGNAL_ARGS);
+
+#define die(msg) pg_fatal("%s: %m", _(msg))
+
+
+int
+main(int argc, char *argv[])
+{
+	double		seq_rate;
+	double		random_rate;
+
+	pg_logging_init(argv[0]);
+	set_pglocale_pgservice(argv[0], PG_TEXTDOMAIN("pg_test_pagecost"));
+	progname = get_progname(argv[0]);
+
+	handle_args(argc, argv);
+
+	/* Prevent leaving behind the test file */
+	pqsignal(SIGINT, signal_cleanup);
+	pqsignal(SIGTERM, signal_cleanup);
+
+	/* the following are not valid on Windows */
+#ifndef WIN32
+	pqsignal(SIGALRM, process_alarm);
+	pqsignal(SIGHUP, signal_cleanup);
+#endif
+
+	pg_prng_seed(&pg_global_prng_state, (uint64) time(NULL));
+
+	create_test_file();
+
+	seq_rate = test_sequential_reads();
+	random_rate = test_random_reads();
+
+	print_suggestion(seq_rate, random_rate);
+
+	unlink(filename);
+
+	return 0;
+}
+
+static void
+handle_args(int argc, char *argv[])
+{
+	static struct option long_options[] = {
+		{"filename", required_argument, NULL, 'f'},
+		{"secs-per-test", required_argument, NULL, 's'},
+		{"file-size", required_argument, NULL, 'S'},
+		{NULL, 0, NULL, 0}
+	};
+
+	int			option;			/* Command line option */
+	int			optindex = 0;	/* used by getopt_long */
+	unsigned long optval;		/* used for option parsing */
+	char	   *endptr;
+
+	if (argc > 1)
+	{
+		if (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-?") == 0)
+		{
+			printf(_("Usage: %s [-f FILENAME] [-s SECS-PER-TEST] [-S FILE-SIZE-MB]\n"),
+				   progname);
+			exit(0);
+		}
+		if (strcmp(argv[1], "--version") == 0 || strcmp(argv[1], "-V") == 0)
+		{
+			puts("pg_test_pagecost (PostgreSQL) " PG_VERSION);
+			exit(0);
+		}
+	}
+
+	while ((option = getopt_long(argc, argv, "f:s:S:",
+								 long_options, &optindex)) != -1)
+	{
+		switch (option)
+		{
+			case 'f':
+				filename = pg_strdup(optarg);
+				break;
+
+			case 's':
+				errno = 0;
+				optval = strtoul(optarg, &endptr, 10);
+
+				if (endptr == optarg || *endptr != '\0' ||
+					errno != 0 || optval != (unsigned int) optval)
+				{
+					pg_log_error("invalid argument for option %s", "--secs-per-test");
+					pg_log_error_hint("Try \"%s --help\" for more information.", progname);
+					exit(1);
+				}
+
+				secs_per_test = (unsigned int) optval;
+				if (secs_per_test == 0)
+					pg_fatal("%s must be in range %u..%u",
+							 "--secs-per-test", 1, UINT_MAX);
+				break;
+
+			case 'S':
+				errno = 0;
+				optval = strtoul(optarg, &endptr, 10);
+
+				if (endptr == optarg || *endptr != '\0' ||
+					errno != 0 || optval != (unsigned int) optval)
+				{
+					pg_log_error("invalid argument for option %s", "--file-size");
+					pg_log_error_hint("Try \"%s --help\" for more information.", progname);
+					exit(1);
+				}
+
+				file_size_mb = (unsigned int) optval;
+				if (file_size_mb < 16)
+					pg_fatal("%s must be in range %u..%u",
+							 "--file-size", 16, UINT_MAX);
+				break;
+
+			default:
+				/* getopt_long already emitted a complaint */
+				pg_log_error_hint("Try \"%s --help\" for more information.", progname);
+				exit(1);
+		}
+	}
+
+	if (argc > optind)
+	{
+		pg_log_error("too many command-line arguments (first is \"%s\")",
+					 argv[optind]);
+		pg_log_error_hint("Try \"%s --help\" for more information.", progname);
+		exit(1);
+	}
+
+	total_pages = (uint64) file_size_mb * 1024 * 1024 / BLCKSZ;
+
+	printf(ngettext("%u second per test\n",
+					"%u seconds per test\n",
+					secs_per_test),
+		   secs_per_test);
+	printf(_("%u MB test file (%llu pages of %d bytes)\n"),
+		   file_size_mb, (unsigned long long) total_pages, BLCKSZ);
+#ifndef POSIX_FADV_DONTNEED
+	printf(_("WARNING: cannot ask the kernel to discard cached pages on this platform;\n"
+			 "results will partly reflect cache speed, not storage speed.\n"));
+#endif
+}
+
+/*
+ * Fill the scratch file with pseudo-random data and force it to storage, so
+ * that the read tests below measure the device and not delayed allocation.
+ */
+static void
+create_test_file(void)
+{
+	int			fd;
+	char	   *chunk;
+	uint64		pages_written = 0;
+
+	printf(_("creating test file...\n"));
+
+	if ((fd = open(filename, O_RDWR | O_CREAT | O_TRUNC | PG_BINARY,
+				   S_IRUSR | S_IWUSR)) == -1)
+		die("could not open output file");
+	needs_unlink = 1;
+
+	chunk = pg_malloc(WRITE_CHUNK_PAGES * BLCKSZ);
+	for (int i = 0; i < WRITE_CHUNK_PAGES * BLCKSZ; i += sizeof(uint64))
+	{
+		uint64		r = pg_prng_uint64(&pg_global_prng_state);
+
+		memcpy(chunk + i, &r, sizeof(uint64));
+	}
+
+	while (pages_written < total_pages)
+	{
+		int			npages = Min(WRITE_CHUNK_PAGES,
+								 (int) (total_pages - pages_written));
+
+		if (write(fd, chunk, npages * BLCKSZ) != npages * BLCKSZ)
+			die("write failed");
+		pages_written += npages;
+	}
+	pg_free(chunk);
+
+	if (fsync(fd) != 0)
+		die("fsync failed");
+	if (close(fd) != 0)
+		die("could not close output file");
+}
+
+/*
+ * Ask the kernel to forget its cached copy of the test file, where we know
+ * how.  Best effort; the tests are still meaningful without it as long as
+ * the file is larger than RAM.
+ */
+static void
+discard_cache(int fd)
+{
+#ifdef POSIX_FADV_DONTNEED
+	(void) posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+}
+
+/*
+ * Read the file front to back in BLCKSZ chunks until the timer fires,
+ * returning pages per second.  If we reach the end before the timer, the
+ * cache is discarded and the read restarts from the beginning, so repeated
+ * passes keep measuring storage.
+ */
+static double
+test_sequential_reads(void)
+{
+	int			fd;
+	uint64		ops = 0;
+
+	printf(_("sequential page reads... "));
+	fflush(stdout);
+
+	if ((fd = open(filename, O_RDONLY | PG_BINARY, 0)) == -1)
+		die("could not open output file");
+	discard_cache(fd);
+
+	START_TIMER;
+	while (!alarm_triggered)
+	{
+		ssize_t		ret = read(fd, page_buf, BLCKSZ);
+
+		if (ret < 0)
+			die("read failed");
+		if (ret == 0)
+		{
+			/* wrapped around: don't re-read from cache */
+			discard_cache(fd);
+			if (lseek(fd, 0, SEEK_SET) == -1)
+				die("seek failed");
+			continue;
+		}
+		ops++;
+	}
+	STOP_TIMER;
+	close(fd);
+
+	printf(_("%13.3f pages/sec\n"), ops / elapsed_secs(start_t, stop_t));
+
+	return ops / elapsed_secs(start_t, stop_t);
+}
+
+/*
+ * Read single pages at uniformly random offsets until the timer fires,
+ * returning pages per second.
+ */
+static double
+test_random_reads(void)
+{
+	int			fd;
+	uint64		ops = 0;
+
+	printf(_("random page reads...     "));
+	fflush(stdout);
+
+	if ((fd = open(filename, O_RDONLY | PG_BINARY, 0)) == -1)
+		die("could not open output file");
+	discard_cache(fd);
+
+	START_TIMER;
+	while (!alarm_triggered)
+	{
+		uint64		page = pg_prng_uint64_range(&pg_global_prng_state,
+												0, total_pages - 1);
+
+		if (lseek(fd, (off_t) (page * BLCKSZ), SEEK_SET) == -1)
+			die("seek failed");
+		if (read(fd, page_buf, BLCKSZ) != BLCKSZ)
+			die("read failed");
+		ops++;
+	}
+	STOP_TIMER;
+	close(fd);
+
+	printf(_("%13.3f pages/sec\n"), ops / elapsed_secs(start_t, stop_t));
+
+	return ops / elapsed_secs(start_t, stop_t);
+}
+
+static void
+print_suggestion(double seq_rate, double random_rate)
+{
+	double		ratio;
+
+	if (random_rate <= 0 || seq_rate <= 0)
+		pg_fatal("no reads completed; results are unusable");
+
+	ratio = seq_rate / random_rate;
+	if (ratio < 1.0)
+		ratio = 1.0;
+
+	printf(_("\nRaw random-to-sequential cost ratio: %.1f\n"), ratio);
+	printf(_("\nSuggested planner settings:\n"));
+	printf("	seq_page_cost = 1.0\n");
+	printf("	random_page_cost = %.1f\n", ratio);
+	printf(_("\nCaveats: the measured ratio assumes no caching.  Pages the server finds\n"
+			 "in shared_buffers or the OS cache cost neither sequential nor random I/O,\n"
+			 "which is why the stock defaults are lower than raw device ratios; consider\n"
+			 "scaling the suggestion down if your working set is mostly cached.  Run with\n"
+			 "a --file-size larger than RAM for trustworthy numbers.\n"));
+}
+
+static double
+elapsed_secs(struct timeval start, struct timeval stop)
+{
+	return ((stop.tv_sec - start.tv_sec) * USECS_SEC +
+			(stop.tv_usec - start.tv_usec)) / (double) USECS_SEC;
+}
+
+#ifndef WIN32
+static void
+process_alarm(SIGNAL_ARGS)
+{
+	alarm_triggered = true;
+}
+#else
+static DWORD WINAPI
+process_alarm(LPVOID param)
+{
+	/* WIN32 doesn't support alarm, so we create a thread and sleep here */
+	Sleep(secs_per_test * 1000);
+	alarm_triggered = true;
+	ExitThread(0);
+}
+#endif
+
+static void
+signal_cleanup(SIGNAL_ARGS)
+{
+	int			rc;
+
+	/* Delete the file if it exists. Ignore errors */
+	if (needs_unlink)
+		unlink(filename);
+	/* Finish incomplete line on stdout */
+	rc = write(STDOUT_FILENO, "\n", 1);
+	(void) rc;					/* silence compiler warnings */
+	_exit(1);
+}
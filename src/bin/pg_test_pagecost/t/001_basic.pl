@@ -0,0 +1,32 @@
+# Copyright (c) 2021-2025, PostgreSQL Global Development Group
+
+use strict;
+use warnings FATAL => 'all';
+
+use PostgreSQL::Test::Utils;
+use Test::More;
+
+#########################################
+# Basic checks
+
+program_help_ok('pg_test_pagecost');
+program_version_ok('pg_test_pagecost');
+program_options_handling_ok('pg_test_pagecost');
+
+#########################################
+# Test invalid option combinations
+
+command_fails_like(
+	[ 'pg_test_pagecost', '--secs-per-test' => 'a' ],
+	qr/\Qpg_test_pagecost: error: invalid argument for option --secs-per-test\E/,
+	'pg_test_pagecost: invalid argument for option --secs-per-test');
+command_fails_like(
+	[ 'pg_test_pagecost', '--secs-per-test' => '0' ],
+	qr/\Qpg_test_pagecost: error: --secs-per-test must be in range 1..4294967295\E/,
+	'pg_test_pagecost: --secs-per-test must be in range');
+command_fails_like(
+	[ 'pg_test_pagecost', '--file-size' => '1' ],
+	qr/\Qpg_test_pagecost: error: --file-size must be in range 16..4294967295\E/,
+	'pg_test_pagecost: --file-size must be in range');
+
+done_testing();
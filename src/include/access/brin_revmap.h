@@ -36,6 +36,12 @@ extern void brinSetHeapBlockItemptr(Buffer buf, BlockNumber pagesPerRange,
 extern BrinTuple *brinGetTupleForHeapBlock(BrinRevmap *revmap,
 										   BlockNumber heapBlk, Buffer *buf, OffsetNumber *off,
 										   Size *size, int mode);
+extern int	brinRevmapGetTids(BrinRevmap *revmap, BlockNumber heapBlk,
+							  ItemPointerData *tids, int ntids);
+extern BrinTuple *brinGetTupleForHeapBlockAtTid(BrinRevmap *revmap,
+												BlockNumber heapBlk, ItemPointerData tid,
+												Buffer *buf, OffsetNumber *off,
+												Size *size, int mode);
 extern bool brinRevmapDesummarizeRange(Relation idxrel, BlockNumber heapBlk);
 
 #endif							/* BRIN_REVMAP_H */
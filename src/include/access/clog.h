@@ -29,6 +29,46 @@ typedef int XidStatus;
 #define TRANSACTION_STATUS_ABORTED			0x02
 #define TRANSACTION_STATUS_SUB_COMMITTED	0x03
 
+/* We need two bits per xact, so four xacts fit in a byte */
+#define CLOG_BITS_PER_XACT	2
+#define CLOG_XACTS_PER_BYTE 4
+#define CLOG_XACT_BITMASK	((1 << CLOG_BITS_PER_XACT) - 1)
+
+/* We store the latest async LSN for each group of transactions */
+#define CLOG_XACTS_PER_LSN_GROUP	32	/* keep this a power of 2 */
+
+/*
+ * Status data for a run of CLOG_STATUS_CHUNK_XACTS consecutive transactions,
+ * copied out of the clog in one shot by TransactionIdGetStatusChunk() so
+ * that transam.c can answer nearby lookups without taking a bank lock.  The
+ * status bytes fit in one cache line.
+ */
+#define CLOG_STATUS_CHUNK_XACTS		256
+#define CLOG_STATUS_CHUNK_BYTES		(CLOG_STATUS_CHUNK_XACTS / CLOG_XACTS_PER_BYTE)
+#define CLOG_STATUS_CHUNK_LSNS		(CLOG_STATUS_CHUNK_XACTS / CLOG_XACTS_PER_LSN_GROUP)
+
+typedef struct ClogStatusChunk
+{
+	char		bytes[CLOG_STATUS_CHUNK_BYTES]; /* two status bits per xact */
+	XLogRecPtr	group_lsn[CLOG_STATUS_CHUNK_LSNS];
+} ClogStatusChunk;
+
+/*
+ * Extract the status, and the matching group LSN, of the transaction at
+ * zero-based offset chunkoff within a chunk.  See the caveats at
+ * TransactionIdGetStatusChunk about which copied bits may be trusted.
+ */
+static inline XidStatus
+ClogStatusChunkGetStatus(const ClogStatusChunk *chunk, uint32 chunkoff,
+						 XLogRecPtr *lsn)
+{
+	int			bshift = (chunkoff % CLOG_XACTS_PER_BYTE) * CLOG_BITS_PER_XACT;
+
+	*lsn = chunk->group_lsn[chunkoff / CLOG_XACTS_PER_LSN_GROUP];
+	return (chunk->bytes[chunkoff / CLOG_XACTS_PER_BYTE] >> bshift) &
+		CLOG_XACT_BITMASK;
+}
+
 typedef struct xl_clog_truncate
 {
 	int64		pageno;
@@ -39,6 +79,9 @@ typedef struct xl_clog_truncate
 extern void TransactionIdSetTreeStatus(TransactionId xid, int nsubxids,
 									   TransactionId *subxids, XidStatus status, XLogRecPtr lsn);
 extern XidStatus TransactionIdGetStatus(TransactionId xid, XLogRecPtr *lsn);
+extern XidStatus TransactionIdGetStatusChunk(TransactionId xid, XLogRecPtr *lsn,
+											 TransactionId *chunkstart,
+											 ClogStatusChunk *chunk);
 
 extern Size CLOGShmemSize(void);
 extern void CLOGShmemInit(void);
@@ -43,8 +43,18 @@ typedef struct TableScanDescData
 	 */
 	union
 	{
-		/* Iterator for Bitmap Table Scans */
-		TBMIterator rs_tbmiterator;
+		/* State for Bitmap Table Scans */
+		struct
+		{
+			/* Iterator over the bitmap's pages */
+			TBMIterator rs_tbmiterator;
+
+			/*
+			 * Highest read stream look-ahead distance reached so far, filled
+			 * in by the table AM for EXPLAIN ANALYZE.
+			 */
+			int			rs_maxlookahead;
+		}			bitmap;
 
 		/*
 		 * Range of ItemPointers for table_scan_getnextslot_tidrange() to
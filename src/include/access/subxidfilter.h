@@ -0,0 +1,80 @@
+/*-------------------------------------------------------------------------
+ *
+ * subxidfilter.h
+ *	  Bloom filter summarizing the subtransaction XIDs of a transaction.
+ *
+ * Each backend maintains one of these in its PGPROC, adding every
+ * subtransaction XID it assigns.  When a snapshot has overflowed the
+ * per-backend subxid caches, GetSnapshotData() stores the union of the
+ * filters of all running transactions in the snapshot, which lets
+ * XidInMVCCSnapshot() skip the pg_subtrans lookup for XIDs that are
+ * certainly not subtransactions of any transaction that was running when
+ * the snapshot was taken.
+ *
+ * Bits are only ever added while the owning transaction runs; the filter
+ * is reset when it ends (aborted subtransactions leave their bits behind,
+ * which is harmless).  A false positive merely costs the pg_subtrans
+ * lookup that would have been made anyway.
+ *
+ * Portions Copyright (c) 1996-2025, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/access/subxidfilter.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef SUBXIDFILTER_H
+#define SUBXIDFILTER_H
+
+#include "common/hashfn.h"
+
+/* Filter size in bits; must be a power of two. */
+#define SUBXID_FILTER_BITS		2048
+#define SUBXID_FILTER_WORDS		(SUBXID_FILTER_BITS / 64)
+
+typedef struct SubxidFilter
+{
+	uint64		words[SUBXID_FILTER_WORDS];
+} SubxidFilter;
+
+/*
+ * We set two bits per XID, taken from independent parts of a single 32-bit
+ * hash.  With 2048 bits, a transaction with 256 live subtransactions still
+ * excludes roughly 95% of unrelated XIDs.
+ */
+static inline void
+SubxidFilterAdd(SubxidFilter *filter, TransactionId xid)
+{
+	uint32		hash = murmurhash32(xid);
+	uint32		bit1 = hash % SUBXID_FILTER_BITS;
+	uint32		bit2 = (hash >> 16) % SUBXID_FILTER_BITS;
+
+	filter->words[bit1 / 64] |= UINT64CONST(1) << (bit1 % 64);
+	filter->words[bit2 / 64] |= UINT64CONST(1) << (bit2 % 64);
+}
+
+static inline bool
+SubxidFilterMayContain(const SubxidFilter *filter, TransactionId xid)
+{
+	uint32		hash = murmurhash32(xid);
+	uint32		bit1 = hash % SUBXID_FILTER_BITS;
+	uint32		bit2 = (hash >> 16) % SUBXID_FILTER_BITS;
+
+	return (filter->words[bit1 / 64] & (UINT64CONST(1) << (bit1 % 64))) != 0 &&
+		(filter->words[bit2 / 64] & (UINT64CONST(1) << (bit2 % 64))) != 0;
+}
+
+static inline void
+SubxidFilterUnion(SubxidFilter *dst, const SubxidFilter *src)
+{
+	for (int i = 0; i < SUBXID_FILTER_WORDS; i++)
+		dst->words[i] |= src->words[i];
+}
+
+static inline void
+SubxidFilterReset(SubxidFilter *filter)
+{
+	memset(filter->words, 0, sizeof(filter->words));
+}
+
+#endif							/* SUBXIDFILTER_H */
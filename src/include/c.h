@@ -377,6 +377,20 @@
 #define unlikely(x) ((x) != 0)
 #endif
 
+/*
+ * Hint the CPU to fetch the cache line containing addr into the cache
+ * hierarchy, in anticipation of a read.  A no-op where not supported.
+ *
+ * Like likely()/unlikely(), use this sparingly: issuing prefetches for
+ * addresses that are in cache anyway, or too close to their use, just wastes
+ * issue slots.
+ */
+#if defined(__GNUC__)
+#define pg_prefetch_mem(addr) __builtin_prefetch(addr)
+#else
+#define pg_prefetch_mem(addr) ((void) 0)
+#endif
+
 /*
  * CppAsString
  *		Convert the argument to a string, using the C preprocessor.
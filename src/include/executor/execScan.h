@@ -14,9 +14,63 @@
 #define EXECSCAN_H
 
 #include "miscadmin.h"
+#include "access/stratnum.h"
 #include "executor/executor.h"
 #include "nodes/execnodes.h"
 
+/*
+ * Precomputed state for the simple-comparison qual fast path.
+ *
+ * ExecScanInitSimpleQual() fills this in when a scan node's qual is a
+ * single "Var op Const" btree comparison on an int4 column, letting the
+ * scan bypass the general expression machinery for each tuple.
+ */
+typedef struct ExecScanSimpleQual
+{
+	AttrNumber	attnum;			/* comparison column (1-based) */
+	int32		cmpval;			/* constant to compare against */
+	StrategyNumber strategy;	/* BTLessStrategyNumber etc., with the Var
+								 * on the left */
+} ExecScanSimpleQual;
+
+extern void ExecScanInitSimpleQual(ScanState *node);
+
+/*
+ * Apply a simple-comparison qual to one scan tuple.
+ *
+ * NULL column values fail the qual, matching the behavior of the strict
+ * comparison operators this fast path recognizes.
+ */
+static inline bool
+ExecScanSimpleQualCheck(const ExecScanSimpleQual *sq, TupleTableSlot *slot)
+{
+	Datum		d;
+	bool		isnull;
+	int32		val;
+
+	d = slot_getattr(slot, sq->attnum, &isnull);
+	if (isnull)
+		return false;
+	val = DatumGetInt32(d);
+
+	switch (sq->strategy)
+	{
+		case BTLessStrategyNumber:
+			return val < sq->cmpval;
+		case BTLessEqualStrategyNumber:
+			return val <= sq->cmpval;
+		case BTEqualStrategyNumber:
+			return val == sq->cmpval;
+		case BTGreaterEqualStrategyNumber:
+			return val >= sq->cmpval;
+		case BTGreaterStrategyNumber:
+			return val > sq->cmpval;
+		default:
+			Assert(false);
+			return false;
+	}
+}
+
 /*
  * ExecScanFetch -- check interrupts & fetch next potential tuple
  *
@@ -212,7 +266,10 @@ ExecScanExtended(ScanState *node,
 		 * when the qual is null ... saves only a few cycles, but they add up
 		 * ...
 		 */
-		if (qual == NULL || ExecQual(qual, econtext))
+		if (qual == NULL ||
+			(node->ss_simplequal != NULL ?
+			 ExecScanSimpleQualCheck(node->ss_simplequal, slot) :
+			 ExecQual(qual, econtext)))
 		{
 			/*
 			 * Found a satisfactory scan tuple.
@@ -322,6 +322,9 @@ typedef struct AggStatePerHashData
 }			AggStatePerHashData;
 
 
+/* GUC */
+extern PGDLLIMPORT bool hashagg_spill_compress;
+
 extern AggState *ExecInitAgg(Agg *node, EState *estate, int eflags);
 extern void ExecEndAgg(AggState *node);
 extern void ExecReScanAgg(AggState *node);
@@ -85,6 +85,7 @@ extern PGDLLIMPORT char *jit_provider;
 extern PGDLLIMPORT bool jit_debugging_support;
 extern PGDLLIMPORT bool jit_dump_bitcode;
 extern PGDLLIMPORT bool jit_expressions;
+extern PGDLLIMPORT bool jit_cache_expressions;
 extern PGDLLIMPORT bool jit_profiling_support;
 extern PGDLLIMPORT bool jit_tuple_deforming;
 extern PGDLLIMPORT double jit_above_cost;
@@ -20,6 +20,14 @@
  *	  - ST_SCOPE - scope (e.g. extern, static inline) for functions
  *	  - ST_CHECK_FOR_INTERRUPTS - if defined the sort is interruptible
  *
+ *	  Optionally, the threshold below which partitions are finished with
+ *	  insertion sort can be overridden.  The default of 7 elements suits
+ *	  expensive comparators; specializations whose comparator inlines to a
+ *	  handful of instructions (e.g. fixed-width integer keys) amortize the
+ *	  per-partition overhead better with a larger threshold.
+ *
+ *	  - ST_INSERTION_SORT_THRESHOLD - partition size cutoff, default 7
+ *
  *	  Instead of ST_ELEMENT_TYPE, ST_ELEMENT_TYPE_VOID can be defined.  Then
  *	  the generated functions will automatically gain an "element_size"
  *	  parameter.  This allows us to generate a traditional qsort function.
@@ -211,6 +219,10 @@ ST_SCOPE void ST_SORT(ST_ELEMENT_TYPE * first, size_t n
 #define DO_CHECK_FOR_INTERRUPTS()
 #endif
 
+#ifndef ST_INSERTION_SORT_THRESHOLD
+#define ST_INSERTION_SORT_THRESHOLD 7
+#endif
+
 /*
  * Create wrapper macros that know how to invoke compare, med3 and sort with
  * the right arguments.
@@ -309,7 +321,7 @@ ST_SORT(ST_ELEMENT_TYPE * data, size_t n
 
 loop:
 	DO_CHECK_FOR_INTERRUPTS();
-	if (n < 7)
+	if (n < ST_INSERTION_SORT_THRESHOLD)
 	{
 		for (pm = a + ST_POINTER_STEP; pm < a + n * ST_POINTER_STEP;
 			 pm += ST_POINTER_STEP)
@@ -332,7 +344,7 @@ loop:
 	if (presorted)
 		return;
 	pm = a + (n / 2) * ST_POINTER_STEP;
-	if (n > 7)
+	if (n > ST_INSERTION_SORT_THRESHOLD)
 	{
 		pl = a;
 		pn = a + (n - 1) * ST_POINTER_STEP;
@@ -427,6 +439,7 @@ loop:
 #undef ST_COMPARE_RUNTIME_POINTER
 #undef ST_ELEMENT_TYPE
 #undef ST_ELEMENT_TYPE_VOID
+#undef ST_INSERTION_SORT_THRESHOLD
 #undef ST_MAKE_NAME
 #undef ST_MAKE_NAME_
 #undef ST_MAKE_PREFIX
@@ -1621,6 +1621,8 @@ typedef struct ScanState
 	Relation	ss_currentRelation;
 	struct TableScanDescData *ss_currentScanDesc;
 	TupleTableSlot *ss_ScanTupleSlot;
+	/* simple-comparison qual fast path, or NULL; see execScan.c */
+	struct ExecScanSimpleQual *ss_simplequal;
 } ScanState;
 
 /* ----------------
@@ -1751,6 +1753,7 @@ typedef struct IndexScanState
  *		SharedInfo		   parallel worker instrumentation (no leader entry)
  *		TableSlot		   slot for holding tuples fetched from the table
  *		VMBuffer		   buffer in use for visibility map testing, if any
+ *		HeapFetchBlock	   block most recently found not all-visible, if any
  *		PscanLen		   size of parallel index-only scan descriptor
  *		NameCStringAttNums attnums of name typed columns to pad to NAMEDATALEN
  *		NameCStringCount   number of elements in the NameCStringAttNums array
@@ -1774,6 +1777,7 @@ typedef struct IndexOnlyScanState
 	SharedIndexScanInstrumentation *ioss_SharedInfo;
 	TupleTableSlot *ioss_TableSlot;
 	Buffer		ioss_VMBuffer;
+	BlockNumber ioss_HeapFetchBlock;
 	Size		ioss_PscanLen;
 	AttrNumber *ioss_NameCStringAttNums;
 	int			ioss_NameCStringCount;
@@ -1820,12 +1824,14 @@ typedef struct BitmapIndexScanState
  *
  *		exact_pages		   total number of exact pages retrieved
  *		lossy_pages		   total number of lossy pages retrieved
+ *		max_lookahead	   highest read stream look-ahead distance reached
  * ----------------
  */
 typedef struct BitmapHeapScanInstrumentation
 {
 	uint64		exact_pages;
 	uint64		lossy_pages;
+	int			max_lookahead;
 } BitmapHeapScanInstrumentation;
 
 /* ----------------
@@ -2358,6 +2364,9 @@ typedef struct MemoizeState
 										 * populating the cache. */
 	struct MemoizeEntry *entry; /* the entry that 'last_tuple' belongs to or
 								 * NULL if 'last_tuple' is NULL. */
+	struct MemoizeEntry *last_entry;	/* entry found by the previous
+										 * cache_lookup, or NULL if it may
+										 * have moved or been evicted since */
 	bool		singlerow;		/* true if the cache entry is to be marked as
 								 * complete after caching the first tuple. */
 	bool		binary_mode;	/* true when cache key should be compared bit
@@ -2409,6 +2418,8 @@ typedef struct SortState
 	bool		am_worker;		/* are we a worker? */
 	bool		datumSort;		/* Datum sort instead of tuple sort? */
 	SharedSortInfo *shared_info;	/* one entry per worker */
+	SharedSortBound *shared_bound;	/* bound shared between participants of a
+									 * parallel bounded sort, or NULL */
 } SortState;
 
 /* ----------------
@@ -2461,6 +2472,8 @@ typedef struct IncrementalSortState
 	bool		outerNodeDone;	/* finished fetching tuples from outer node */
 	int64		bound_Done;		/* value of bound we did the sort with */
 	IncrementalSortExecutionStatus execution_status;
+	int64		min_group_size; /* current full-sort batch size; grows while
+								 * consecutive batches end on tiny groups */
 	int64		n_fullsort_remaining;
 	Tuplesortstate *fullsort_state; /* private state of tuplesort.c */
 	Tuplesortstate *prefixsort_state;	/* private state of tuplesort.c */
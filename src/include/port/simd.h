@@ -404,6 +404,7 @@ vector32_eq(const Vector32 v1, const Vector32 v2)
 }
 #endif							/* ! USE_NO_SIMD */
 
+
 /*
  * Given two vectors, return a vector with the minimum element of each.
  */
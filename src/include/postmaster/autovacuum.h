@@ -23,6 +23,8 @@
 typedef enum
 {
 	AVW_BRINSummarizeRange,
+	AVW_GINCleanPendingList,
+	AVW_HashExpandTable,
 } AutoVacuumWorkItemType;
 
 
@@ -668,6 +668,10 @@ struct ReorderBuffer
 	char	   *outbuf;
 	Size		outbufsize;
 
+	/* scratch buffer for compressing/decompressing spilled changes */
+	char	   *cmpbuf;
+	Size		cmpbufsize;
+
 	/* memory accounting */
 	Size		size;
 
@@ -85,6 +85,7 @@ PG_LWLOCK(50, DSMRegistry)
 PG_LWLOCK(51, InjectionPoint)
 PG_LWLOCK(52, SerialControl)
 PG_LWLOCK(53, AioWorkerSubmissionQueue)
+PG_LWLOCK(54, LogicalSnapshotWrite)
 
 /*
  * There also exist several built-in LWLock tranches.  As with the predefined
@@ -115,7 +116,6 @@ PG_LWLOCKTRANCHE(PARALLEL_QUERY_DSA, ParallelQueryDSA)
 PG_LWLOCKTRANCHE(PER_SESSION_DSA, PerSessionDSA)
 PG_LWLOCKTRANCHE(PER_SESSION_RECORD_TYPE, PerSessionRecordType)
 PG_LWLOCKTRANCHE(PER_SESSION_RECORD_TYPMOD, PerSessionRecordTypmod)
-PG_LWLOCKTRANCHE(SHARED_TUPLESTORE, SharedTupleStore)
 PG_LWLOCKTRANCHE(SHARED_TIDBITMAP, SharedTidBitmap)
 PG_LWLOCKTRANCHE(PARALLEL_APPEND, ParallelAppend)
 PG_LWLOCKTRANCHE(PER_XACT_PREDICATE_LIST, PerXactPredicateList)
@@ -15,6 +15,7 @@
 #define _PROC_H_
 
 #include "access/clog.h"
+#include "access/subxidfilter.h"
 #include "access/xlogdefs.h"
 #include "lib/ilist.h"
 #include "storage/latch.h"
@@ -286,6 +287,8 @@ struct PGPROC
 	XidCacheStatus subxidStatus;	/* mirrored with
 									 * ProcGlobal->subxidStates[i] */
 	struct XidCache subxids;	/* cache for subtransaction XIDs */
+	SubxidFilter subxidsFilter; /* summary of *all* our subxact XIDs,
+								 * including any that overflowed subxids */
 
 	/* Support for group XID clearing. */
 	/* true, if member of ProcArray group waiting for XID clear */
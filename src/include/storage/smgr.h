@@ -46,6 +46,15 @@ typedef struct SMgrRelationData
 	BlockNumber smgr_targblock; /* current insertion target block */
 	BlockNumber smgr_cached_nblocks[MAX_FORKNUM + 1];	/* last known size */
 
+	/*
+	 * Backend-local cache of a recent free space map search, maintained by
+	 * freespace.c.  Reset together with smgr_targblock on cache flush
+	 * events, which covers relation truncation.
+	 */
+	BlockNumber smgr_fsm_targblock; /* block found by last FSM search */
+	uint8		smgr_fsm_cat;	/* free space category it satisfied */
+	uint8		smgr_fsm_uses;	/* uses left before a fresh search */
+
 	/* additional public fields may someday exist here */
 
 	/*
@@ -306,6 +306,8 @@ extern void GetCurrentTimeUsec(struct pg_tm *tm, fsec_t *fsec, int *tzp);
 extern void j2date(int jd, int *year, int *month, int *day);
 extern int	date2j(int year, int month, int day);
 
+extern bool ParseISODateTimeFast(const char *str, struct pg_tm *tm,
+								 fsec_t *fsec);
 extern int	ParseDateTime(const char *timestr, char *workbuf, size_t buflen,
 						  char **field, int *ftype,
 						  int maxfields, int *numfields);
@@ -13,6 +13,7 @@
 #ifndef SNAPSHOT_H
 #define SNAPSHOT_H
 
+#include "access/subxidfilter.h"
 #include "lib/pairingheap.h"
 
 
@@ -177,6 +178,15 @@ typedef struct SnapshotData
 	int32		subxcnt;		/* # of xact ids in subxip[] */
 	bool		suboverflowed;	/* has the subxip array overflowed? */
 
+	/*
+	 * For suboverflowed snapshots not taken during recovery, the union of
+	 * the subxid Bloom filters of all transactions in progress, letting
+	 * XidInMVCCSnapshot() skip pg_subtrans lookups for XIDs that certainly
+	 * aren't subtransactions.  Only meaningful when subxfilter_valid.
+	 */
+	SubxidFilter subxfilter;
+	bool		subxfilter_valid;
+
 	bool		takenDuringRecovery;	/* recovery-shaped snapshot? */
 	bool		copied;			/* false if it's a static snapshot */
 
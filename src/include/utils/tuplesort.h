@@ -25,6 +25,7 @@
 #include "access/gin_tuple.h"
 #include "access/itup.h"
 #include "executor/tuptable.h"
+#include "port/atomics.h"
 #include "storage/dsm.h"
 #include "utils/logtape.h"
 #include "utils/relcache.h"
@@ -38,6 +39,22 @@
 typedef struct Tuplesortstate Tuplesortstate;
 typedef struct Sharedsort Sharedsort;
 
+/*
+ * When several processes each run a bounded sort over a partition of the
+ * same input (as below Gather Merge with a LIMIT), they can share the
+ * tightest leading-key bound seen by any of them, letting every process
+ * discard tuples that cannot make the overall top-N without a full
+ * comparison.  The key stored here is the SortTuple datum1 value of some
+ * process's current heap maximum, normalized so that smaller always means
+ * "sorts earlier"; it is only used when the leading comparator is
+ * ssup_datum_unsigned_cmp, whose leading-key ordering is total.
+ */
+typedef struct SharedSortBound
+{
+	bool		instrumented;	/* is a SharedSortInfo appended to this? */
+	pg_atomic_uint64 bound_key; /* tightest normalized bound published */
+} SharedSortBound;
+
 /*
  * Tuplesort parallel coordination state, allocated by each participant in
  * local memory.  Participant caller initializes everything.  See usage notes
@@ -249,6 +266,18 @@ typedef struct
 
 	bool		tuples;			/* Can SortTuple.tuple ever be set? */
 
+	/*
+	 * Used only by the MinimalTuple routines: when the two leading sort keys
+	 * are plain int4 columns sorted by the standard ordering operators (and
+	 * Datum is wide enough), both keys are encoded into datum1 as a single
+	 * unsigned 64-bit value, so that the leading comparison covers two keys
+	 * with one branchless unsigned comparison.  See tuplesort_begin_heap.
+	 */
+	bool		packKeys;		/* pack two leading int4 keys into datum1? */
+	AttrNumber	packAttno2;		/* attribute number of the second key */
+	uint32		packLoXor;		/* bit transform for the second key */
+	uint32		packLoNull;		/* low-word encoding of a NULL second key */
+
 	void	   *arg;			/* Specific information for the sort variant */
 } TuplesortPublic;
 
@@ -377,6 +406,8 @@ extern Tuplesortstate *tuplesort_begin_common(int workMem,
 											  int sortopt);
 extern void tuplesort_set_bound(Tuplesortstate *state, int64 bound);
 extern bool tuplesort_used_bound(Tuplesortstate *state);
+extern void tuplesort_set_shared_bound(Tuplesortstate *state,
+									   pg_atomic_uint64 *bound_key);
 extern void tuplesort_puttuple_common(Tuplesortstate *state,
 									  SortTuple *tuple, bool useAbbrev,
 									  Size tuplen);
@@ -39,6 +39,9 @@
  */
 typedef struct Tuplestorestate Tuplestorestate;
 
+/* GUC variable */
+extern PGDLLIMPORT bool tuplestore_spill_compress;
+
 /*
  * Currently we only need to store MinimalTuples, but it would be easy
  * to support the same behavior for IndexTuples and/or bare Datums.
@@ -29,6 +29,7 @@
 
 #include <numa.h>
 #include <numaif.h>
+#include <sched.h>
 
 /*
  * numa_move_pages() chunk size, has to be <= 16 to work around a kernel bug
@@ -106,6 +107,43 @@ pg_numa_get_max_node(void)
 	return numa_max_node();
 }
 
+/*
+ * Return the NUMA node the calling process is currently executing on, or -1
+ * if that cannot be determined.  The result is only a hint: the scheduler
+ * can migrate the process to another node at any time.
+ */
+int
+pg_numa_get_current_node(void)
+{
+	int			cpu;
+
+	/* callers are not required to have called pg_numa_init() */
+	if (numa_available() < 0)
+		return -1;
+
+	cpu = sched_getcpu();
+	if (cpu < 0)
+		return -1;
+
+	return numa_node_of_cpu(cpu);
+}
+
+/*
+ * Ask the kernel to interleave the pages of the given memory range across
+ * all NUMA nodes, rather than leaving them subject to the default first-touch
+ * policy.  This must be called before the range is faulted in to have any
+ * effect.  Returns 0 on success, -1 if NUMA is not available.
+ */
+int
+pg_numa_interleave_memory(void *start, size_t size)
+{
+	if (numa_available() < 0)
+		return -1;
+
+	numa_interleave_memory(start, size, numa_all_nodes_ptr);
+	return 0;
+}
+
 #else
 
 /* Empty wrappers */
@@ -128,4 +166,16 @@ pg_numa_get_max_node(void)
 	return 0;
 }
 
+int
+pg_numa_get_current_node(void)
+{
+	return -1;
+}
+
+int
+pg_numa_interleave_memory(void *start, size_t size)
+{
+	return -1;
+}
+
 #endif